@@ -1,6 +1,7 @@
 #include "ast.hpp"
 
 #include <utility>
+#include <algorithm>
 #include <numeric>
 
 #include "utils.hpp"
@@ -19,9 +20,6 @@ Identifier::Identifier()
 ASTProgramNode::ASTProgramNode(const std::string& name, const std::string& name_space, const std::vector<std::shared_ptr<ASTNode>>& statements)
 	: ASTNode(row, col), name(name), name_space(name_space), statements(statements), libs(std::vector<std::shared_ptr<ASTProgramNode>>()) {}
 
-ASTBuiltinCallNode::ASTBuiltinCallNode(std::string identifier, size_t row, size_t col)
-	: ASTStatementNode(row, col), identifier(identifier) {}
-
 ASTUsingNode::ASTUsingNode(const std::vector<std::string>& library, size_t row, size_t col)
 	: ASTStatementNode(row, col), library(library) {}
 
@@ -73,7 +71,52 @@ ASTSwitchNode::ASTSwitchNode(std::shared_ptr<ASTExprNode> condition, const std::
 	const std::map<std::shared_ptr<ASTExprNode>, size_t>& case_blocks,
 	size_t default_block, size_t row, size_t col)
 	: ASTStatementNode(row, col), condition(condition), statements(statements), case_blocks(case_blocks),
-	default_block(default_block), parsed_case_blocks(std::map<size_t, size_t>()) {}
+	default_block(default_block) {}
+
+void SwitchTable::build(const std::map<intmax_t, size_t>& cases, bool integral, size_t default_block) {
+	dense_min = 0;
+	dense_blocks.clear();
+	hashed_blocks.clear();
+
+	if (cases.empty()) {
+		return;
+	}
+
+	// cases are ordered, so the span is given by the first and last keys
+	auto min = cases.begin()->first;
+	auto max = cases.rbegin()->first;
+	auto span = static_cast<uintmax_t>(max) - static_cast<uintmax_t>(min);
+
+	if (integral && span < std::max<uintmax_t>(16, cases.size() * 4)) {
+		dense_min = min;
+		dense_blocks.assign(static_cast<size_t>(span) + 1, default_block);
+		for (const auto& [hash, pos] : cases) {
+			dense_blocks[static_cast<size_t>(static_cast<uintmax_t>(hash) - static_cast<uintmax_t>(min))] = pos;
+		}
+		return;
+	}
+
+	hashed_blocks.reserve(cases.size());
+	hashed_blocks.insert(cases.begin(), cases.end());
+}
+
+size_t SwitchTable::find(intmax_t hash, size_t default_block) const {
+	if (!dense_blocks.empty()) {
+		auto index = static_cast<uintmax_t>(hash) - static_cast<uintmax_t>(dense_min);
+		return index < dense_blocks.size() ? dense_blocks[index] : default_block;
+	}
+
+	auto it = hashed_blocks.find(hash);
+	return it != hashed_blocks.end() ? it->second : default_block;
+}
+
+void SwitchTable::build_strings(const std::unordered_multimap<intmax_t, std::pair<std::shared_ptr<ASTExprNode>, size_t>>& cases) {
+	string_blocks = cases;
+}
+
+bool SwitchTable::empty() const {
+	return dense_blocks.empty() && hashed_blocks.empty() && string_blocks.empty();
+}
 
 ASTIfNode::ASTIfNode(std::shared_ptr<ASTExprNode> condition, std::shared_ptr<ASTBlockNode> if_block, const std::vector<std::shared_ptr<ASTElseIfNode>>& else_ifs,
 	std::shared_ptr<ASTBlockNode> else_block, size_t row, size_t col)
@@ -331,7 +374,16 @@ void ASTUnaryExprNode::accept(Visitor* v) {
 	v->visit(std::dynamic_pointer_cast<ASTUnaryExprNode>(shared_from_this()));
 }
 
-intmax_t ASTUnaryExprNode::hash(Visitor* v) { return 0; }
+intmax_t ASTUnaryExprNode::hash(Visitor* v) {
+	// negative constant cases
+	if (unary_op == "-") {
+		if (const auto& literal = std::dynamic_pointer_cast<ASTLiteralNode<flx_float>>(expr)) {
+			return Visitor::hash_float(-literal->value);
+		}
+		return -expr->hash(v);
+	}
+	return 0;
+}
 
 void ASTTernaryNode::accept(Visitor* v) {
 	v->visit(std::dynamic_pointer_cast<ASTTernaryNode>(shared_from_this()));
@@ -480,7 +532,3 @@ void ASTUsingNode::accept(Visitor* v) {
 void ASTProgramNode::accept(Visitor* v) {
 	v->visit(std::dynamic_pointer_cast<ASTProgramNode>(shared_from_this()));
 }
-
-void ASTBuiltinCallNode::accept(Visitor* v) {
-	v->visit(std::dynamic_pointer_cast<ASTBuiltinCallNode>(shared_from_this()));
-}
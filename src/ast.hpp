@@ -5,8 +5,10 @@
 #include <array>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <memory>
 
+#include "atom.hpp"
 #include "types.hpp"
 #include "visitor.hpp"
 
@@ -14,8 +16,10 @@ namespace core {
 
 	class Identifier {
 	public:
-		std::string identifier;
+		Atom identifier;
 		std::vector<std::shared_ptr<ASTExprNode>> access_vector;
+		// struct member slot resolved by the semantic analyser
+		mutable size_t slot = StructShape::npos;
 
 		Identifier(const std::string& identifier, const std::vector<std::shared_ptr<ASTExprNode>>& access_vector);
 
@@ -55,7 +59,7 @@ namespace core {
 	class ASTProgramNode : public ASTNode {
 	public:
 		std::string name;
-		std::string name_space;
+		Atom name_space;
 		std::vector<std::shared_ptr<ASTNode>> statements;
 		std::vector<std::shared_ptr<ASTProgramNode>> libs;
 
@@ -65,16 +69,6 @@ namespace core {
 		void accept(Visitor*) override;
 	};
 
-	class ASTBuiltinCallNode : public ASTStatementNode {
-	public:
-		std::string identifier;
-
-		ASTBuiltinCallNode(std::string identifier,
-			size_t row, size_t col);
-
-		void accept(Visitor*) override;
-	};
-
 	class ASTUsingNode : public ASTStatementNode {
 	public:
 		std::vector<std::string> library;
@@ -87,7 +81,7 @@ namespace core {
 
 	class ASTNamespaceManagerNode : public ASTStatementNode {
 	public:
-		std::string name_space;
+		Atom name_space;
 
 		ASTNamespaceManagerNode(const std::string& name_space, size_t col, size_t row);
 
@@ -110,7 +104,7 @@ namespace core {
 
 	class ASTDeclarationNode : public ASTStatementNode, public TypeDefinition {
 	public:
-		std::string identifier;
+		Atom identifier;
 		std::shared_ptr<ASTExprNode> expr;
 		bool is_const;
 
@@ -137,11 +131,13 @@ namespace core {
 
 	class ASTAssignmentNode : public ASTStatementNode {
 	public:
-		std::string identifier;
-		std::string name_space;
+		Atom identifier;
+		Atom name_space;
 		std::vector<Identifier> identifier_vector;
 		std::string op;
 		std::shared_ptr<ASTExprNode> expr;
+		// set by the semantic analysis when a plain variable of a primitive type receives a value of the same type
+		Type value_type = Type::T_UNDEFINED;
 
 		ASTAssignmentNode(const std::vector<Identifier>& identifier_vector, const std::string& name_space,
 			const std::string& op, std::shared_ptr<ASTExprNode> expr, size_t row, size_t col);
@@ -164,6 +160,11 @@ namespace core {
 	class ASTReturnNode : public ASTStatementNode {
 	public:
 		std::shared_ptr<ASTExprNode> expr;
+		// set by the semantic analysis when the returned value already has the primitive return type of the function
+		bool exact_type = false;
+		// set by the semantic analysis when the returned expression is a plain call in tail position,
+		// so the call reuses the frame of the returning function
+		bool tail_call = false;
 
 		ASTReturnNode(std::shared_ptr<ASTExprNode> expr, size_t row, size_t col);
 
@@ -173,6 +174,8 @@ namespace core {
 	class ASTBlockNode : public ASTStatementNode {
 	public:
 		std::vector<std::shared_ptr<ASTNode>> statements;
+		// cleared by the semantic analyser when the block declares nothing, so it runs in the enclosing scope
+		bool declares_symbols = true;
 
 		ASTBlockNode(const std::vector<std::shared_ptr<ASTNode>>& statements, size_t row, size_t col);
 
@@ -202,11 +205,30 @@ namespace core {
 		void accept(Visitor*) override;
 	};
 
+	// case jump table of a switch, built by the semantic analyser from the case value hashes
+	class SwitchTable {
+	public:
+		// integral cases spanning a small range are indexed directly by value - dense_min
+		intmax_t dense_min = 0;
+		std::vector<size_t> dense_blocks;
+		std::unordered_map<intmax_t, size_t> hashed_blocks;
+		// string cases keep their expression, a hash hit is only taken when the case value matches
+		std::unordered_multimap<intmax_t, std::pair<std::shared_ptr<ASTExprNode>, size_t>> string_blocks;
+
+		void build(const std::map<intmax_t, size_t>& cases, bool integral, size_t default_block);
+		void build_strings(const std::unordered_multimap<intmax_t, std::pair<std::shared_ptr<ASTExprNode>, size_t>>& cases);
+		size_t find(intmax_t hash, size_t default_block) const;
+		bool empty() const;
+	};
+
 	class ASTSwitchNode : public ASTStatementNode {
 	public:
 		std::shared_ptr<ASTExprNode> condition;
 		std::map<std::shared_ptr<ASTExprNode>, size_t> case_blocks;
-		std::map<size_t, size_t> parsed_case_blocks;
+		SwitchTable parsed_case_blocks;
+		// set when the condition type is only known at runtime
+		bool check_condition_type = false;
+		TypeDefinition case_type;
 		size_t default_block;
 		std::vector<std::shared_ptr<ASTNode>> statements;
 
@@ -276,10 +298,21 @@ namespace core {
 		void accept(Visitor*) override;
 	};
 
+	// canonical integer counted loop, recognized by the semantic analyser in for (var i = a; i < b; i++)
+	class CountedLoop {
+	public:
+		Atom counter;
+		// relational operator of the condition and its right side
+		std::string op;
+		std::shared_ptr<ASTExprNode> bound;
+		flx_int step;
+	};
+
 	class ASTForNode : public ASTStatementNode {
 	public:
 		std::array<std::shared_ptr<ASTNode>, 3> expressions;
 		std::shared_ptr<ASTBlockNode> block;
+		std::shared_ptr<CountedLoop> counted;
 
 		ASTForNode(const std::array<std::shared_ptr<ASTNode>, 3>& expressions, std::shared_ptr<ASTBlockNode> block, size_t row, size_t col);
 
@@ -316,7 +349,7 @@ namespace core {
 
 	class ASTStructDefinitionNode : public ASTStatementNode {
 	public:
-		std::string identifier;
+		Atom identifier;
 		std::map<std::string, VariableDefinition> variables;
 
 		ASTStructDefinitionNode(const std::string& identifier, const std::map<std::string, VariableDefinition>& variables,
@@ -327,7 +360,7 @@ namespace core {
 
 	class ASTFunctionDefinitionNode : public ASTStatementNode, public TypeDefinition {
 	public:
-		std::string identifier;
+		Atom identifier;
 		std::vector<TypeDefinition*> parameters;
 		std::shared_ptr<ASTBlockNode> block;
 
@@ -362,6 +395,10 @@ namespace core {
 	class ASTLambdaFunction : public ASTExprNode {
 	public:
 		std::shared_ptr<ASTFunctionDefinitionNode> fun;
+		// names the body resolves in the blocks enclosing the lambda, captured when it is evaluated
+		std::vector<std::string> captures;
+		// shared definition of the closures created by this lambda, built on its first evaluation
+		std::shared_ptr<FunctionDefinition> definition;
 
 		ASTLambdaFunction(std::shared_ptr<ASTFunctionDefinitionNode> fun, size_t row, size_t col);
 
@@ -379,11 +416,22 @@ namespace core {
 		virtual intmax_t hash(Visitor*) override;
 	};
 
+	// construction template of a struct type, built by the interpreter on first construction
+	class StructConstructorPrototype {
+	public:
+		size_t definition_id;
+		// slot and member definition of each provided value, in values order
+		std::vector<std::pair<size_t, VariableDefinition>> values;
+		// slots left out by the constructor, filled with null
+		std::vector<std::pair<size_t, Type>> defaults;
+	};
+
 	class ASTStructConstructorNode : public ASTExprNode {
 	public:
 		std::string type_name;
-		std::string name_space;
+		Atom name_space;
 		std::map<std::string, std::shared_ptr<ASTExprNode>> values;
+		std::shared_ptr<StructConstructorPrototype> prototype;
 
 		ASTStructConstructorNode(const std::string& type_name, const std::string& name_space,
 			const std::map<std::string, std::shared_ptr<ASTExprNode>>& values, size_t row, size_t col);
@@ -413,6 +461,8 @@ namespace core {
 		std::string op;
 		std::shared_ptr<ASTExprNode> left;
 		std::shared_ptr<ASTExprNode> right;
+		// set by the semantic analysis when both operands are statically of the same primitive type
+		Type operand_type = Type::T_UNDEFINED;
 
 		ASTBinaryExprNode(const std::string& op, std::shared_ptr<ASTExprNode> left, std::shared_ptr<ASTExprNode> right, size_t row, size_t col);
 
@@ -433,8 +483,8 @@ namespace core {
 
 	class ASTIdentifierNode : public ASTExprNode {
 	public:
-		std::string identifier;
-		std::string name_space;
+		Atom identifier;
+		Atom name_space;
 		std::vector<Identifier> identifier_vector;
 
 		explicit ASTIdentifierNode(const std::vector<Identifier>& identifier_vector, std::string name_space, size_t row, size_t col);
@@ -469,12 +519,16 @@ namespace core {
 
 	class ASTFunctionCallNode : public ASTExprNode {
 	public:
-		std::string name_space;
-		std::string identifier;
+		Atom name_space;
+		Atom identifier;
 		std::vector<Identifier> identifier_vector;
 		std::vector<std::shared_ptr<ASTExprNode>> parameters;
 		std::vector<Identifier> expression_identifier_vector;
 		std::shared_ptr<ASTFunctionCallNode> expression_call;
+		// body and parameter names of a callee with a single return, set by the semantic analysis
+		// when the overload is fixed and the arguments have exactly its parameter types
+		std::shared_ptr<ASTBlockNode> inline_block;
+		std::vector<std::string> inline_parameters;
 
 		ASTFunctionCallNode(const std::string& name_space, const std::vector<Identifier>& identifier_vector, const std::vector<std::shared_ptr<ASTExprNode>>& parameters,
 			std::vector<Identifier> expression_identifier_vector, std::shared_ptr<ASTFunctionCallNode> expression_call, size_t row, size_t col);
@@ -0,0 +1,34 @@
+#include "atom.hpp"
+
+#include <unordered_set>
+
+using namespace core;
+
+const std::string* Atom::intern(const std::string& value) {
+	// node based set, so interned strings never move
+	static std::unordered_set<std::string> table;
+	return &*table.insert(value).first;
+}
+
+Atom::Atom() {
+	static const std::string* empty = intern("");
+	value = empty;
+}
+
+Atom::Atom(const std::string& value)
+	: value(intern(value)) {}
+
+Atom::Atom(const char* value)
+	: value(intern(value)) {}
+
+const std::string& Atom::str() const {
+	return *value;
+}
+
+bool Atom::empty() const {
+	return value->empty();
+}
+
+Atom::operator const std::string& () const {
+	return *value;
+}
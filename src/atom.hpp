@@ -0,0 +1,67 @@
+#ifndef ATOM_HPP
+#define ATOM_HPP
+
+#include <string>
+#include <functional>
+#include <ostream>
+
+namespace core {
+
+	// interned name, atoms of equal strings share the same storage,
+	// so they are compared and hashed by address
+	class Atom {
+	private:
+		const std::string* value;
+
+		static const std::string* intern(const std::string& value);
+
+	public:
+		Atom();
+		Atom(const std::string& value);
+		Atom(const char* value);
+
+		const std::string& str() const;
+		bool empty() const;
+
+		operator const std::string& () const;
+
+		friend bool operator==(const Atom& l, const Atom& r) {
+			return l.value == r.value;
+		}
+
+		friend bool operator!=(const Atom& l, const Atom& r) {
+			return l.value != r.value;
+		}
+
+		friend std::string operator+(const std::string& l, const Atom& r) {
+			return l + *r.value;
+		}
+
+		friend std::string operator+(const Atom& l, const std::string& r) {
+			return *l.value + r;
+		}
+
+		friend std::string operator+(const char* l, const Atom& r) {
+			return l + *r.value;
+		}
+
+		friend std::string operator+(const Atom& l, const char* r) {
+			return *l.value + r;
+		}
+
+		friend std::ostream& operator<<(std::ostream& os, const Atom& atom) {
+			return os << *atom.value;
+		}
+
+		friend struct AtomHash;
+	};
+
+	struct AtomHash {
+		size_t operator()(const Atom& atom) const noexcept {
+			return std::hash<const std::string*>()(atom.value);
+		}
+	};
+
+}
+
+#endif // !ATOM_HPP
@@ -9,6 +9,8 @@
 #include "md_input.hpp"
 #include "md_sound.hpp"
 #include "md_http.hpp"
+#include "md_collections.hpp"
+#include "md_strings.hpp"
 
 using namespace core;
 
@@ -29,7 +31,8 @@ std::unordered_map<BuintinFuncs, std::string> const Constants::BUILTIN_NAMES = {
 	{READCH, "readch"},
 	{LEN, "len"},
 	{SLEEP, "sleep"},
-	{SYSTEM, "system"}
+	{SYSTEM, "system"},
+	{HASH, "hash"}
 };
 
 std::vector<std::string> const Constants::STD_LIBS = {
@@ -62,5 +65,7 @@ std::unordered_map<std::string, std::shared_ptr<modules::Module>> const Constant
 	{"flx.core.datetime", std::shared_ptr<modules::ModuleDateTime>(new modules::ModuleDateTime())},
 	{"flx.core.input", std::shared_ptr<modules::ModuleInput>(new modules::ModuleInput())},
 	{"flx.core.sound", std::shared_ptr<modules::ModuleSound>(new modules::ModuleSound())},
-	{"flx.core.HTTP", std::shared_ptr<modules::ModuleHTTP>(new modules::ModuleHTTP())}
+	{"flx.core.HTTP", std::shared_ptr<modules::ModuleHTTP>(new modules::ModuleHTTP())},
+	{"flx.core.collections", std::shared_ptr<modules::ModuleCollections>(new modules::ModuleCollections())},
+	{"flx.core.strings", std::shared_ptr<modules::ModuleStrings>(new modules::ModuleStrings())}
 };
@@ -17,7 +17,8 @@ namespace core {
 		READCH,
 		LEN,
 		SLEEP,
-		SYSTEM
+		SYSTEM,
+		HASH
 	};
 
 	class Constants {
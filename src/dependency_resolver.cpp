@@ -52,7 +52,6 @@ void DependencyResolver::visit(std::shared_ptr<ASTUnpackedDeclarationNode>) {}
 void DependencyResolver::visit(std::shared_ptr<ASTAssignmentNode>) {}
 void DependencyResolver::visit(std::shared_ptr<ASTFunctionExpressionAssignmentNode>) {}
 
-void DependencyResolver::visit(std::shared_ptr<ASTBuiltinCallNode>) {}
 void DependencyResolver::visit(std::shared_ptr<ASTFunctionCallNode>) {}
 void DependencyResolver::visit(std::shared_ptr<ASTFunctionDefinitionNode>) {}
 
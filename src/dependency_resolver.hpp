@@ -76,7 +76,6 @@ namespace core {
 			void visit(std::shared_ptr<ASTIsArrayNode>) override;
 			void visit(std::shared_ptr<ASTIsAnyNode>) override;
 			void visit(std::shared_ptr<ASTValueNode>) override;
-			void visit(std::shared_ptr<ASTBuiltinCallNode>) override;
 
 			intmax_t hash(std::shared_ptr<ASTExprNode>) override;
 			intmax_t hash(std::shared_ptr<ASTValueNode>) override;
@@ -6,6 +6,7 @@
 #include "parser.hpp"
 #include "utils.hpp"
 #include "dependency_resolver.hpp"
+#include "optimizer.hpp"
 #include "interpreter.hpp"
 
 using namespace interpreter;
@@ -119,11 +120,22 @@ int FlexaInterpreter::interpreter() {
 		SemanticAnalyser semantic_analyser(semantic_global_scope, main_program, programs, args.program_args);
 		semantic_analyser.start();
 
+		if (args.optimization_level > 0) {
+			Optimizer optimizer(main_program, programs, args.optimization_level);
+			optimizer.start();
+		}
+
 		intmax_t result = 0;
 
 		if (args.engine == "ast") {
 			Interpreter interpreter(interpreter_global_scope, main_program, programs, args.program_args);
-			interpreter.start();
+			interpreter.max_call_depth = args.max_call_depth;
+			interpreter.stack_size = Interpreter::execution_stack_size(args.max_call_depth);
+
+			// runs on a stack sized for the maximum call depth, so deep recursion fails with a catchable error
+			utils::ThreadUtils::run_with_stack_size(interpreter.stack_size, [&interpreter]() {
+				interpreter.start();
+			});
 			result = interpreter.current_expression_value->get_i();
 		}
 		else {
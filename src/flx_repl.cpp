@@ -130,7 +130,11 @@ int FlexaRepl::execute(const FlexaCliArgs& args) {
 			semantic_analyser.start();
 
 			Interpreter interpreter(interpreter_global_scope, program, programs, args.program_args);
-			interpreter.visit(program);
+			interpreter.max_call_depth = args.max_call_depth;
+			interpreter.stack_size = Interpreter::execution_stack_size(args.max_call_depth);
+			utils::ThreadUtils::run_with_stack_size(interpreter.stack_size, [&interpreter, &program]() {
+				interpreter.visit(program);
+			});
 
 			if (file_load) {
 				std::cout << std::endl << "File loaded successfully." << std::endl;
@@ -78,6 +78,20 @@ void FlexaCliArgs::parse_args() {
 			engine = args[i];
 			continue;
 		}
+		if (arg == "-O0" || arg == "-O1" || arg == "-O2") {
+			optimization_level = arg[2] - '0';
+			continue;
+		}
+		if (arg == "--max-call-depth") {
+			++i;
+			throw_if_not_parameter(args_size, i, arg);
+			std::string p = args[i];
+			if (p.empty() || p.size() > 18 || p.find_first_not_of("0123456789") != std::string::npos || std::stoull(p) == 0) {
+				throw std::runtime_error("invalid " + arg + " parameter value: '" + p + "'");
+			}
+			max_call_depth = std::stoull(p);
+			continue;
+		}
 		if (arg == "-w" || arg == "--workspace") {
 			++i;
 			throw_if_not_parameter(args_size, i, arg);
@@ -29,6 +29,9 @@ namespace interpreter {
 
 	public:
 		bool debug = false;
+		size_t optimization_level = 1;
+		// above the depth the default native stack used to allow, the execution stack is sized from it
+		size_t max_call_depth = 10000;
 		std::string engine;
 		std::string libs_path;
 		std::string workspace_path;
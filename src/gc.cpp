@@ -97,6 +97,18 @@ void GarbageCollector::remove_array_root(std::weak_ptr<flx_array> array_root) {
 	}
 }
 
+void GarbageCollector::add_weak_object(GCWeakObject* obj) {
+	weak_objects.push_back(obj);
+}
+
+void GarbageCollector::add_native_object(GCObject* obj) {
+	native_objects.insert(obj);
+}
+
+bool GarbageCollector::is_native_object(GCObject* obj) const {
+	return native_objects.contains(obj);
+}
+
 void GarbageCollector::mark() {
 	for (auto it = roots.begin(); it != roots.end();) {
 		if (*it) {
@@ -152,6 +164,27 @@ void GarbageCollector::mark() {
 			it = array_roots.erase(it);
 		}
 	}
+
+	mark_weak_objects();
+}
+
+void GarbageCollector::mark_weak_objects() {
+	// repeat until no live weak object reaches new objects
+	bool marked_any = true;
+	while (marked_any) {
+		marked_any = false;
+		for (auto obj : weak_objects) {
+			if (!obj->marked) {
+				continue;
+			}
+			for (GCObject* referenced : obj->get_conditional_references()) {
+				if (referenced && !referenced->marked) {
+					mark_object(referenced);
+					marked_any = true;
+				}
+			}
+		}
+	}
 }
 
 void GarbageCollector::mark_object(GCObject* obj) {
@@ -161,11 +194,29 @@ void GarbageCollector::mark_object(GCObject* obj) {
 	for (GCObject* referenced : obj->get_references()) {
 		mark_object(referenced);
 	}
+
+	auto native = obj->get_native_reference();
+	if (native && is_native_object(native)) {
+		mark_object(native);
+	}
 }
 
 void GarbageCollector::sweep() {
+	for (auto it = weak_objects.begin(); it != weak_objects.end(); ) {
+		if ((*it)->marked) {
+			(*it)->clear_dead_references();
+			++it;
+		}
+		else {
+			it = weak_objects.erase(it);
+		}
+	}
+
 	for (auto it = heap.begin(); it != heap.end(); ) {
 		if (!(*it)->marked) {
+			if (!native_objects.empty()) {
+				native_objects.erase(*it);
+			}
 			delete* it;
 			it = heap.erase(it);
 		}
@@ -2,6 +2,7 @@
 #define GARBAGE_COLLECTOR_HPP
 
 #include <vector>
+#include <unordered_set>
 
 #include "gcobject.hpp"
 #include "types.hpp"
@@ -18,6 +19,9 @@ namespace core {
 			std::vector<std::weak_ptr<GCObject>> var_roots;
 			std::vector<std::weak_ptr<std::vector<RuntimeValue*>>> root_containers;
 			std::vector<std::weak_ptr<flx_array>> array_roots;
+			std::vector<GCWeakObject*> weak_objects;
+			// live native objects, handles are plain ints that scripts can write
+			std::unordered_set<GCObject*> native_objects;
 
 		public:
 			bool enable = true;
@@ -43,7 +47,13 @@ namespace core {
 			void add_array_root(std::weak_ptr<flx_array> array_root);
 			void remove_array_root(std::weak_ptr<flx_array> array_root);
 
+			void add_weak_object(GCWeakObject* obj);
+
+			void add_native_object(GCObject* obj);
+			bool is_native_object(GCObject* obj) const;
+
 			void mark();
+			void mark_weak_objects();
 			void mark_object(GCObject* obj);
 			void sweep();
 			void collect();
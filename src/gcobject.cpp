@@ -3,3 +3,7 @@
 using namespace core::runtime;
 
 GCObject::~GCObject() = default;
+
+GCObject* GCObject::get_native_reference() {
+	return nullptr;
+}
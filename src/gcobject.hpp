@@ -12,6 +12,17 @@ namespace core {
 			bool marked = false;
 			virtual ~GCObject();
 			virtual std::vector<GCObject*> get_references() = 0;
+			// native object named by a handle, only followed when the collector knows it
+			virtual GCObject* get_native_reference();
+		};
+
+		// object that holds references not traced by get_references
+		class GCWeakObject : public GCObject {
+		public:
+			// references that become reachable after mark, like ephemeron values of live keys
+			virtual std::vector<GCObject*> get_conditional_references() = 0;
+			// called at sweep, before unmarked objects are deleted
+			virtual void clear_dead_references() = 0;
 		};
 
 	}
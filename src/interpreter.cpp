@@ -1,6 +1,7 @@
 #include "interpreter.hpp"
 
 #include <filesystem>
+#include <algorithm>
 
 #include "exception_handler.hpp"
 #include "token.hpp"
@@ -13,6 +14,16 @@
 using namespace core;
 using namespace core::runtime;
 
+ThrownError::ThrownError(RuntimeValue* value)
+	: std::runtime_error(""), value(value) {}
+
+const char* ThrownError::what() const noexcept {
+	if (message.empty()) {
+		message = TypeUtils::is_struct(value->type) ? value->find_sub("error")->get_s() : value->get_s();
+	}
+	return message.c_str();
+}
+
 Interpreter::Interpreter(std::shared_ptr<Scope> global_scope, std::shared_ptr<ASTProgramNode> main_program,
 	const std::map<std::string, std::shared_ptr<ASTProgramNode>>& programs, const std::vector<std::string>& args)
 	: Visitor(programs, main_program, main_program ? main_program->name : Constants::DEFAULT_NAMESPACE) {
@@ -50,7 +61,11 @@ void Interpreter::visit(std::shared_ptr<ASTProgramNode> astnode) {
 				break;
 			}
 		}
-		catch (std::runtime_error ex) {
+		catch (const std::runtime_error& ex) {
+			// the error is reported from here on, so a thrown value is no longer needed
+			if (const auto thrown = dynamic_cast<const ThrownError*>(&ex)) {
+				gc.remove_root(thrown->value);
+			}
 			if (curr_row == 0 || curr_col == 0) {
 				set_curr_pos(statement->row, statement->col);
 			}
@@ -142,7 +157,6 @@ void Interpreter::visit(std::shared_ptr<ASTEnumNode> astnode) {
 
 void Interpreter::visit(std::shared_ptr<ASTDeclarationNode> astnode) {
 	set_curr_pos(astnode->row, astnode->col);
-	const auto& name_space = current_program_stack.top()->name_space;
 
 	// evaluate assignment expression
 	if (astnode->expr) {
@@ -156,6 +170,12 @@ void Interpreter::visit(std::shared_ptr<ASTDeclarationNode> astnode) {
 	RuntimeValue* new_value = current_expression_value;
 	clear_current_expression();
 
+	declare_value(astnode, new_value, astnode->expr != nullptr);
+}
+
+void Interpreter::declare_value(std::shared_ptr<ASTDeclarationNode> astnode, RuntimeValue* new_value, bool assigned) {
+	const auto& name_space = current_program_stack.top()->name_space;
+
 	if (!new_value->use_ref) {
 		new_value = allocate_value(new RuntimeValue(new_value));
 	}
@@ -176,7 +196,7 @@ void Interpreter::visit(std::shared_ptr<ASTDeclarationNode> astnode) {
 	if ((!TypeDefinition::is_any_or_match_type(*new_var, *new_value) ||
 		TypeUtils::is_array(new_var->type) && !TypeUtils::is_any(new_var->array_type)
 		&& !TypeDefinition::match_type(*new_var, *new_value, false, true))
-		&& astnode->expr && !TypeUtils::is_undefined(new_value->type) && !TypeUtils::is_array(new_value->type)) {
+		&& assigned && !TypeUtils::is_undefined(new_value->type) && !TypeUtils::is_array(new_value->type)) {
 		ExceptionHandler::throw_declaration_type_err(astnode->identifier, *new_var, *new_value);
 	}
 
@@ -239,6 +259,18 @@ void Interpreter::visit(std::shared_ptr<ASTAssignmentNode> astnode) {
 
 	auto ptr_value = current_expression_value; // saves the ptr into a variable to use after
 
+	// value already of the declared primitive type, no matching or normalization is needed
+	if (astnode->value_type != Type::T_UNDEFINED && !ptr_value->use_ref && !has_string_access
+		&& ptr_value->type == astnode->value_type && variable->type == astnode->value_type) {
+		if (astnode->op == "=") {
+			variable->set_value(allocate_value(new RuntimeValue(ptr_value)));
+			return;
+		}
+		if (value->type == astnode->value_type && RuntimeOperations::do_typed_assignment(astnode->op, value, ptr_value)) {
+			return;
+		}
+	}
+
 	// check if it's reference
 	RuntimeValue* new_value = ptr_value;
 
@@ -248,7 +280,10 @@ void Interpreter::visit(std::shared_ptr<ASTAssignmentNode> astnode) {
 
 	validates_reference_type_assignment(*variable, new_value);
 
-	RuntimeOperations::normalize_type(variable.get(), new_value);
+	// a char assigned into a string position must stay a char
+	if (!has_string_access) {
+		RuntimeOperations::normalize_type(variable.get(), new_value);
+	}
 
 	// handle direct assignment
 	if (astnode->op == "="
@@ -312,6 +347,7 @@ void Interpreter::visit(std::shared_ptr<ASTFunctionExpressionAssignmentNode> ast
 	RuntimeOperations::normalize_type(variable, new_value);
 
 	if (variable->value_ref && TypeUtils::is_string(variable->value_ref->type) && astnode->op == "=" && TypeUtils::is_char(variable->type)) {
+		check_string_position(variable->value_ref, variable->access_index);
 		(*variable->value_ref->get_raw_s())[variable->access_index] = new_value->get_c();
 	}
 	else {
@@ -330,6 +366,14 @@ void Interpreter::visit(std::shared_ptr<ASTReturnNode> astnode) {
 		//auto curr_func_call_id_vector = current_function_call_identifier_vector.top();
 		const auto& curr_func_call_expr_id_vector = current_function_call_expression_identifier_vector.top();
 		const auto& curr_func_call_expr_call = current_function_call_expression_call.top();
+
+		// the call result is returned as is, so the caller frame can run it
+		if (astnode->tail_call && !curr_func_call_expr_call && !has_access(curr_func_call_expr_id_vector)) {
+			schedule_tail_call(std::static_pointer_cast<ASTFunctionCallNode>(astnode->expr));
+			activate_return(name_space);
+			return;
+		}
+
 		// evaluates return expression
 		astnode->expr->accept(this);
 		// keeps return value
@@ -349,11 +393,12 @@ void Interpreter::visit(std::shared_ptr<ASTReturnNode> astnode) {
 			// handle string char access
 			if (TypeUtils::is_string(value->type) && curr_func_call_expr_id_vector.back().access_vector.size() > 0 && has_string_access) {
 				has_string_access = false;
-				std::string str = value->get_s();
+				auto str_value = value;
 				curr_func_call_expr_id_vector.back().access_vector.back()->accept(this);
 				auto pos = current_expression_value->get_i();
+				check_string_position(str_value, pos);
 
-				value = allocate_value(new RuntimeValue(flx_char(str[pos])));
+				value = allocate_value(new RuntimeValue(flx_char(str_value->get_sv()[pos])));
 				value->value_ref = returned_value;
 				value->access_index = pos;
 			}
@@ -369,6 +414,10 @@ void Interpreter::visit(std::shared_ptr<ASTReturnNode> astnode) {
 		current_expression_value = allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 	}
 
+	activate_return(name_space);
+}
+
+void Interpreter::activate_return(const std::string& name_space) {
 	// return node activates return flow
 	for (intmax_t i = scopes[name_space].size() - 1; i >= 0; --i) {
 		if (!scopes[name_space][i]->name.empty()) {
@@ -379,13 +428,46 @@ void Interpreter::visit(std::shared_ptr<ASTReturnNode> astnode) {
 	}
 }
 
+void Interpreter::schedule_tail_call(std::shared_ptr<ASTFunctionCallNode> astnode) {
+	std::string identifier;
+	bool pop_program = false;
+	tail_call_signature.clear();
+	tail_call_arguments = std::make_shared<std::vector<RuntimeValue*>>();
+
+	// rooted until the caller frame takes the arguments over
+	gc.add_root_container(tail_call_arguments);
+
+	tail_call_function = find_called_function(astnode, current_expression_value, *tail_call_arguments, tail_call_signature, identifier, pop_program);
+	tail_call_program = current_program_stack.top();
+	current_program_stack.pop();
+	tail_call = true;
+
+	clear_current_expression();
+}
+
+void Interpreter::push_environment(const Atom& name_space, const std::shared_ptr<Scope>& environment) {
+	if (environment) {
+		scopes[name_space].push_back(environment);
+	}
+}
+
+void Interpreter::pop_environment(const Atom& name_space, const std::shared_ptr<Scope>& environment) {
+	// the environment belongs to the closure, so it's never pooled
+	if (environment) {
+		scopes[name_space].pop_back();
+	}
+}
+
+bool Interpreter::has_access(const std::vector<Identifier>& identifier_vector) {
+	return identifier_vector.size() > 1
+		|| (identifier_vector.size() == 1 && (!identifier_vector[0].identifier.empty() || !identifier_vector[0].access_vector.empty()));
+}
+
 void Interpreter::visit(std::shared_ptr<ASTFunctionCallNode> astnode) {
 	set_curr_pos(astnode->row, astnode->col);
-	const auto& current_program = current_program_stack.top();
-	auto name_space = astnode->name_space;
-	std::string identifier = astnode->identifier;
-	std::vector<Identifier> identifier_vector = astnode->identifier_vector;
-	bool strict = true;
+	check_call_depth();
+
+	std::string identifier;
 	std::vector<TypeDefinition*> signature;
 	std::shared_ptr<std::vector<RuntimeValue*>> function_arguments = std::make_shared<std::vector<RuntimeValue*>>();
 	bool pop_program = false;
@@ -395,103 +477,167 @@ void Interpreter::visit(std::shared_ptr<ASTFunctionCallNode> astnode) {
 	// adds function args container to root, to prevent values sweep while evaluating each one
 	gc.add_root_container(function_arguments);
 
-	for (auto& param : astnode->parameters) {
-		param->accept(this);
+	auto state = save_call_state();
+	FunctionDefinition* declfun = nullptr;
 
-		// check if it's reference
-		RuntimeValue* pvalue = current_expression_value;
-		clear_current_expression();
-		if (!pvalue->use_ref) {
-			pvalue = allocate_value(new RuntimeValue(pvalue));
-		}
-
-		function_arguments->push_back(pvalue);
-		signature.push_back(pvalue);
+	try {
+		declfun = &find_called_function(astnode, returned_expression_value, *function_arguments, signature, identifier, pop_program);
+	}
+	catch (...) {
+		restore_call_state(state);
+		gc.remove_root_container(function_arguments);
+		throw;
 	}
 
-	std::shared_ptr<Scope> func_scope;
+	run_function(*declfun, identifier, signature, function_arguments, astnode->expression_identifier_vector, astnode->expression_call, pop_program, state);
+}
 
-	// handle function return
-	if (astnode->identifier.empty()) {
-		name_space = returned_expression_value->get_fun().first;
-		identifier = returned_expression_value->get_fun().second;
+RuntimeValue* Interpreter::call(const flx_function& function, std::span<RuntimeValue* const> arguments) {
+	check_call_depth();
 
-		func_scope = find_declared_function_strict(current_program, name_space, identifier, signature, strict, pop_program);
+	std::string identifier;
+	std::vector<TypeDefinition*> signature;
+	auto function_arguments = std::make_shared<std::vector<RuntimeValue*>>();
+	bool pop_program = false;
 
-		if (!func_scope) {
-			ExceptionHandler::undeclared_function(identifier, signature);
+	gc.add_root_container(function_arguments);
+
+	// arguments are bound as a call expression binds its evaluated parameters
+	for (auto argument : arguments) {
+		if (!argument->use_ref) {
+			argument = allocate_value(new RuntimeValue(argument));
 		}
+		function_arguments->push_back(argument);
+		signature.push_back(argument);
+	}
 
+	auto state = save_call_state();
+	FunctionDefinition* declfun = nullptr;
+
+	try {
+		declfun = &find_function_value(function, signature, identifier, pop_program);
+	}
+	catch (...) {
+		restore_call_state(state);
+		gc.remove_root_container(function_arguments);
+		throw;
 	}
-	// handle subvalue call
-	else if (astnode->identifier_vector.size() > 1) {
-		auto idnode = std::make_shared<ASTIdentifierNode>(astnode->identifier_vector, name_space, astnode->row, astnode->col);
-		idnode->accept(this);
 
-		name_space = current_expression_value->get_fun().first;
-		identifier = current_expression_value->get_fun().second;
-		clear_current_expression();
+	run_function(*declfun, identifier, signature, function_arguments, std::vector<Identifier>(), nullptr, pop_program, state);
 
-		func_scope = find_declared_function_strict(current_program, name_space, identifier, signature, strict, pop_program);
+	auto result = current_expression_value;
+	clear_current_expression();
 
-		if (!func_scope) {
-			ExceptionHandler::undeclared_function(identifier, signature);
-		}
+	return result;
+}
 
+void Interpreter::run_function(FunctionDefinition& declfun, const std::string& identifier, const std::vector<TypeDefinition*>& signature,
+	std::shared_ptr<std::vector<RuntimeValue*>> function_arguments, const std::vector<Identifier>& expression_identifier_vector,
+	std::shared_ptr<ASTFunctionCallNode> expression_call, bool pop_program, const CallState& state) {
+	if (declfun.is_builtin) {
+		run_builtin(declfun, function_arguments, expression_identifier_vector, pop_program, state);
+		return;
 	}
-	// handle regular call
-	else {
-		// check if is a common declared function
-		func_scope = find_declared_function_strict(current_program, name_space, identifier, signature, strict, pop_program);
 
-		if (!func_scope) {
-			// set strict to true again to try find from variable
-			strict = true;
+	Atom frame_name_space;
+	size_t frame_scopes = 0;
 
-			auto var_scope = get_inner_most_variable_scope(current_program, name_space, identifier);
+	try {
+		++call_depth;
+		current_function.push(declfun);
+		current_function_defined_parameters.push(declfun.parameters);
+		current_this_name.push(identifier);
+		current_function_signature.push(signature);
+		current_function_call_expression_identifier_vector.push(expression_identifier_vector);
+		current_function_call_expression_call.push(expression_call);
+		current_function_calling_arguments.push(*function_arguments);
+
+		frame_name_space = current_program_stack.top()->name_space;
+		frame_scopes = scopes[frame_name_space].size();
+
+		// the frame keeps its own copy, the closure value may be released while it runs
+		const auto& function = current_function.top();
+		push_environment(frame_name_space, function.environment);
+
+		// it's not a stack cause it's one shot use, right it reachs block it's cleaned
+		function_call_name = identifier;
+		function.block->accept(this);
+		pop_environment(frame_name_space, function.environment);
+
+		// a return in tail position schedules its call instead of running it,
+		// so the callee runs here in place of the finished frame, in constant stack
+		if (tail_call) {
+			// return types of the replaced frames the callee's declared type doesn't satisfy,
+			// the value the chain ends with is checked against them
+			std::vector<FunctionDefinition> unchecked_returns;
+
+			while (tail_call && !exit_from_program) {
+				tail_call = false;
+
+				const auto& replaced = current_function.top();
+				if (!TypeUtils::is_any(replaced.type) && (TypeUtils::is_any(tail_call_function.type)
+					|| !TypeDefinition::match_type(replaced, tail_call_function))
+					&& std::none_of(unchecked_returns.begin(), unchecked_returns.end(), [&replaced](const FunctionDefinition& function) {
+						return function.identifier == replaced.identifier && TypeDefinition::match_type(function, replaced, true, true);
+						})) {
+					unchecked_returns.push_back(replaced);
+				}
 
-			// if there's no variable
-			if (!var_scope) {
-				ExceptionHandler::undeclared_function(identifier, signature);
-			}
+				gc.remove_root_container(function_arguments);
+				function_arguments = tail_call_arguments;
+				tail_call_arguments = nullptr;
 
-			// gets variable value
-			auto var = std::dynamic_pointer_cast<RuntimeVariable>(var_scope->find_declared_variable(identifier));
-			auto var_value = var->get_value();
+				current_program_stack.pop();
+				current_program_stack.push(tail_call_program);
+				tail_call_program = nullptr;
 
-			// if variable is not a function type, throw error
-			if (!TypeUtils::is_function(var_value->type)) {
-				ExceptionHandler::undeclared_function(identifier, signature);
-			}
+				// natives return right away, there is no frame to take over
+				if (tail_call_function.is_builtin) {
+					current_expression_value = call_builtin(tail_call_function, *function_arguments);
+					break;
+				}
 
-			// get function namespace and name
-			name_space = var_value->get_fun().first;
-			identifier = var_value->get_fun().second;
+				current_function.top() = tail_call_function;
+				current_function_defined_parameters.push(tail_call_function.parameters);
+				current_this_name.top() = tail_call_function.identifier;
+				current_function_signature.top() = tail_call_signature;
+				current_function_calling_arguments.push(*function_arguments);
 
-			func_scope = find_declared_function_strict(current_program, name_space, identifier, signature, strict, pop_program);
+				frame_name_space = current_program_stack.top()->name_space;
+				frame_scopes = scopes[frame_name_space].size();
 
-			if (!func_scope) {
-				ExceptionHandler::undeclared_function(identifier, signature);
+				push_environment(frame_name_space, current_function.top().environment);
+				function_call_name = tail_call_function.identifier;
+				current_function.top().block->accept(this);
+				pop_environment(frame_name_space, current_function.top().environment);
 			}
 
+			// the innermost replaced frame reports first, as its return would have
+			for (auto it = unchecked_returns.rbegin(); !exit_from_program && it != unchecked_returns.rend(); ++it) {
+				if (!TypeDefinition::is_any_or_match_type(*it, *current_expression_value)) {
+					ExceptionHandler::throw_return_type_err(it->identifier, *it, *current_expression_value);
+				}
+			}
 		}
-
+	}
+	catch (...) {
+		// the error leaves the frame, so a catching try block continues from a consistent state
+		if (!frame_name_space.empty()) {
+			while (scopes[frame_name_space].size() > frame_scopes) {
+				pop_scope(frame_name_space);
+			}
+		}
+		restore_call_state(state);
+		gc.remove_root_container(function_arguments);
+		if (tail_call_arguments) {
+			gc.remove_root_container(tail_call_arguments);
+			tail_call_arguments = nullptr;
+		}
+		tail_call = false;
+		throw;
 	}
 
-	auto& declfun = func_scope->find_declared_function(identifier, &signature, strict);
-
-	current_function.push(declfun);
-	current_function_defined_parameters.push(declfun.parameters);
-	current_this_name.push(identifier);
-	current_function_signature.push(signature);
-	current_function_call_expression_identifier_vector.push(astnode->expression_identifier_vector);
-	current_function_call_expression_call.push(astnode->expression_call);
-	current_function_calling_arguments.push(*function_arguments);
-
-	// it's not a stack cause it's one shot use, right it reachs block it's cleaned
-	function_call_name = identifier;
-	declfun.block->accept(this);
-
+	--call_depth;
 	current_function.pop();
 	current_function_call_expression_identifier_vector.pop();
 	current_function_call_expression_call.pop();
@@ -505,19 +651,262 @@ void Interpreter::visit(std::shared_ptr<ASTFunctionCallNode> astnode) {
 
 }
 
-void Interpreter::visit(std::shared_ptr<ASTBuiltinCallNode> astnode) {
-	set_curr_pos(astnode->row, astnode->col);
+void Interpreter::run_builtin(const FunctionDefinition& declfun, std::shared_ptr<std::vector<RuntimeValue*>> function_arguments,
+	const std::vector<Identifier>& expression_identifier_vector, bool pop_program, const CallState& state) {
+	try {
+		current_expression_value = call_builtin(declfun, *function_arguments);
 
-	builtin_functions[astnode->identifier]();
+		if (expression_identifier_vector.size() > 0) {
+			current_expression_value = access_value(current_expression_value, expression_identifier_vector);
+		}
 
-	const auto& expression_identifier_vector = current_function_call_expression_identifier_vector.top();
+		gc.collect();
+	}
+	catch (...) {
+		restore_call_state(state);
+		gc.remove_root_container(function_arguments);
+		throw;
+	}
 
-	if (expression_identifier_vector.size() > 0) {
-		current_expression_value = access_value(current_expression_value, expression_identifier_vector);
+	gc.remove_root_container(function_arguments);
+
+	if (pop_program) {
+		current_program_stack.pop();
 	}
+}
 
-	gc.collect();
+RuntimeValue* Interpreter::call_builtin(const FunctionDefinition& declfun, std::vector<RuntimeValue*>& arguments) {
+	const auto& parameters = declfun.parameters;
+
+	for (size_t i = 0; i < arguments.size() && i < parameters.size(); ++i) {
+		validates_reference_type_assignment(*parameters[i], arguments[i]);
+		RuntimeOperations::normalize_type(parameters[i], arguments[i]);
+		if (!arguments[i]->use_ref) {
+			arguments[i]->ref.reset();
+		}
+	}
+
+	// arguments are bound in place, so the values added here are rooted with them
+	for (size_t i = arguments.size(); i < parameters.size(); ++i) {
+		const auto decl = dynamic_cast<VariableDefinition*>(parameters[i]);
+		if (!decl || decl->is_rest) {
+			break;
+		}
+
+		std::dynamic_pointer_cast<ASTExprNode>(decl->default_value)->accept(this);
+		arguments.push_back(allocate_value(new RuntimeValue(current_expression_value)));
+		clear_current_expression();
+	}
 
+	// the rest parameter takes the remaining arguments as an array, unless it's given a single array
+	const auto rest = parameters.empty() ? nullptr : dynamic_cast<VariableDefinition*>(parameters.back());
+	if (rest && rest->is_rest) {
+		size_t first = parameters.size() - 1;
+		if (arguments.size() != parameters.size() || !TypeUtils::is_array(arguments.back()->type)) {
+			size_t count = arguments.size() > first ? arguments.size() - first : 0;
+			auto arr = flx_array(count);
+			for (size_t i = 0; i < count; ++i) {
+				arr[i] = arguments[first + i];
+			}
+			arguments.resize(first);
+			arguments.push_back(allocate_value(new RuntimeValue(arr, Type::T_ANY, std::vector<size_t>{ count })));
+		}
+	}
+
+	RuntimeValue* result = nullptr;
+	builtin_functions[declfun.builtin_index](arguments, result);
+
+	return result ? result : allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+}
+
+void Interpreter::register_builtin(const std::string& identifier, builtin_func_t function) {
+	auto it = builtin_indexes.find(identifier);
+	if (it != builtin_indexes.end()) {
+		builtin_functions[it->second] = std::move(function);
+		return;
+	}
+
+	builtin_indexes.emplace(identifier, builtin_functions.size());
+	builtin_functions.push_back(std::move(function));
+}
+
+void Interpreter::check_call_depth() {
+	// stacks grow down on the supported platforms
+	char stack_marker;
+	auto stack_address = reinterpret_cast<uintptr_t>(&stack_marker);
+	if (call_depth == 0) {
+		call_stack_base = stack_address;
+	}
+
+	if (max_call_depth > 0 && call_depth >= max_call_depth) {
+		throw std::runtime_error("maximum call depth of " + std::to_string(max_call_depth) + " exceeded");
+	}
+
+	// frames of some calls are larger than the stack was sized for, so the stack can run out first
+	if (stack_size > 0 && call_stack_base - stack_address > stack_size - STACK_SAFETY_MARGIN) {
+		throw std::runtime_error("execution stack exhausted at call depth " + std::to_string(call_depth));
+	}
+}
+
+Interpreter::CallState Interpreter::save_call_state() {
+	return CallState{ call_depth, current_function.size(), current_function_defined_parameters.size(),
+		current_function_calling_arguments.size(), current_this_name.size(), current_function_signature.size(),
+		current_function_call_expression_identifier_vector.size(), current_function_call_expression_call.size(),
+		current_program_stack.size(), is_loop, is_switch };
+}
+
+template<typename T>
+static void truncate_stack(std::stack<T>& stack, size_t size) {
+	while (stack.size() > size) {
+		stack.pop();
+	}
+}
+
+void Interpreter::restore_call_state(const CallState& state) {
+	call_depth = state.call_depth;
+	truncate_stack(current_function, state.functions);
+	truncate_stack(current_function_defined_parameters, state.defined_parameters);
+	truncate_stack(current_function_calling_arguments, state.calling_arguments);
+	truncate_stack(current_this_name, state.this_names);
+	truncate_stack(current_function_signature, state.signatures);
+	truncate_stack(current_function_call_expression_identifier_vector, state.expression_identifier_vectors);
+	truncate_stack(current_function_call_expression_call, state.expression_calls);
+	truncate_stack(current_program_stack, state.programs);
+	is_loop = state.is_loop;
+	is_switch = state.is_switch;
+	function_call_name = "";
+	return_from_function = false;
+	return_from_function_name = "";
+	continue_block = false;
+	break_block = false;
+}
+
+size_t Interpreter::execution_stack_size(size_t max_call_depth) {
+	return max_call_depth * CALL_STACK_SIZE + STACK_SAFETY_MARGIN * 2;
+}
+
+FunctionDefinition& Interpreter::find_called_function(std::shared_ptr<ASTFunctionCallNode> astnode, RuntimeValue* returned_expression_value,
+	std::vector<RuntimeValue*>& function_arguments, std::vector<TypeDefinition*>& signature, std::string& identifier, bool& pop_program) {
+	const auto& current_program = current_program_stack.top();
+	const auto& name_space = astnode->name_space;
+	identifier = astnode->identifier;
+
+	for (auto& param : astnode->parameters) {
+		param->accept(this);
+
+		// check if it's reference
+		RuntimeValue* pvalue = current_expression_value;
+		clear_current_expression();
+		if (!pvalue->use_ref) {
+			pvalue = allocate_value(new RuntimeValue(pvalue));
+		}
+
+		function_arguments.push_back(pvalue);
+		signature.push_back(pvalue);
+	}
+
+	// handle function return
+	if (astnode->identifier.empty()) {
+		return find_function_value(returned_expression_value->get_fun(), signature, identifier, pop_program);
+	}
+
+	// handle subvalue call
+	if (astnode->identifier_vector.size() > 1) {
+		auto idnode = std::make_shared<ASTIdentifierNode>(astnode->identifier_vector, name_space, astnode->row, astnode->col);
+		idnode->accept(this);
+
+		auto fun_value = current_expression_value;
+		clear_current_expression();
+
+		return find_function_value(fun_value->get_fun(), signature, identifier, pop_program);
+	}
+
+	// handle regular call, check if is a common declared function
+	bool strict = true;
+	auto func_scope = find_declared_function_strict(current_program, name_space, identifier, signature, strict, pop_program);
+	if (func_scope) {
+		return *func_scope->find_declared_function(identifier, &signature, strict);
+	}
+
+	auto var_scope = get_inner_most_variable_scope(current_program, name_space, identifier);
+
+	// if there's no variable
+	if (!var_scope) {
+		ExceptionHandler::undeclared_function(identifier, signature);
+	}
+
+	// gets variable value
+	auto var = std::dynamic_pointer_cast<RuntimeVariable>(var_scope->find_declared_variable(identifier));
+	auto var_value = var->get_value();
+
+	// if variable is not a function type, throw error
+	if (!TypeUtils::is_function(var_value->type)) {
+		ExceptionHandler::undeclared_function(identifier, signature);
+	}
+
+	return find_function_value(var_value->get_fun(), signature, identifier, pop_program);
+}
+
+FunctionDefinition& Interpreter::find_function_value(const flx_function& fun, const std::vector<TypeDefinition*>& signature,
+	std::string& identifier, bool& pop_program) {
+	identifier = fun.second;
+
+	// closures aren't declared in any scope, they're called straight through their definition
+	if (fun.definition) {
+		if (!Scope::match_signature(*fun.definition, &signature, true)
+			&& !Scope::match_signature(*fun.definition, &signature, false)) {
+			ExceptionHandler::undeclared_function(identifier, signature);
+		}
+		current_program_stack.push(fun.program);
+		pop_program = true;
+		return *fun.definition;
+	}
+
+	// the handle is used while its scope holds the same declarations, otherwise the name is looked up again
+	if (auto scope = fun.handle ? fun.scope.lock() : nullptr; scope && scope->generation == fun.generation
+		&& Scope::match_signature(*fun.handle, &signature, true)) {
+		current_program_stack.push(scope->owner);
+		pop_program = true;
+		return *fun.handle;
+	}
+
+	bool strict = true;
+	auto func_scope = find_declared_function_strict(current_program_stack.top(), fun.first, identifier, signature, strict, pop_program);
+
+	if (!func_scope) {
+		ExceptionHandler::undeclared_function(identifier, signature);
+	}
+
+	return *func_scope->find_declared_function(identifier, &signature, strict);
+}
+
+std::shared_ptr<Scope> Interpreter::capture_environment(std::shared_ptr<ASTLambdaFunction> astnode) {
+	if (astnode->captures.empty()) {
+		return nullptr;
+	}
+
+	const auto& current_program = current_program_stack.top();
+	const auto& name_scopes = scopes[current_program->name_space];
+	auto environment = std::make_shared<Scope>(current_program);
+
+	// the captured variables are shared, so the closure sees the frame changes and the frame sees the closure ones
+	for (const auto& identifier : astnode->captures) {
+		for (size_t i = name_scopes.size() - 1; i > 0; --i) {
+			const auto& scope = name_scopes[i];
+			if (scope->already_declared_variable(identifier)) {
+				environment->declare_variable(identifier, scope->find_declared_variable(identifier));
+				break;
+			}
+			if (const auto functions = scope->find_declared_functions(identifier)) {
+				for (const auto& function : *functions) {
+					environment->declare_function(identifier, function);
+				}
+				break;
+			}
+		}
+	}
+
+	return environment;
 }
 
 void Interpreter::visit(std::shared_ptr<ASTFunctionDefinitionNode> astnode) {
@@ -525,44 +914,47 @@ void Interpreter::visit(std::shared_ptr<ASTFunctionDefinitionNode> astnode) {
 	const auto& current_program = current_program_stack.top();
 	const auto& name_space = astnode->type_name_space;
 
-	try {
-		// if its already declared, it's a block definition
-		auto& declfun = scopes[name_space].back()->find_declared_function(astnode->identifier, &astnode->parameters, true);
-		declfun.block = astnode->block;
+	// if its already declared, it's a block definition
+	if (auto declfun = scopes[name_space].back()->find_declared_function(astnode->identifier, &astnode->parameters, true)) {
+		declfun->block = astnode->block;
 	}
-	catch (...) {
-		auto& block = astnode->block;
-
-		// if node not has block and it's a builtin, it's create a builtin executor
-		if (!block && builtin_functions.find(astnode->identifier) != builtin_functions.end()) {
-			block = std::make_shared<ASTBlockNode>(std::vector<std::shared_ptr<ASTNode>>{
-				std::make_shared<ASTBuiltinCallNode>(astnode->identifier, astnode->row, astnode->col)
-			}, astnode->row, astnode->col);
+	else {
+		auto definition = FunctionDefinition(astnode->identifier, astnode->type, astnode->type_name, name_space,
+			astnode->array_type, astnode->dim, astnode->parameters, astnode->block, astnode->row, astnode->row);
+
+		// if node not has block and it's a builtin, it's called through the builtin index
+		if (!astnode->block) {
+			auto builtin = builtin_indexes.find(astnode->identifier);
+			if (builtin != builtin_indexes.end()) {
+				definition.is_builtin = true;
+				definition.builtin_index = builtin->second;
+			}
 		}
 
-		scopes[name_space].back()->declare_function(astnode->identifier,
-			FunctionDefinition(astnode->identifier, astnode->type, astnode->type_name, name_space,
-				astnode->array_type, astnode->dim, astnode->parameters, block, astnode->row, astnode->row));
+		scopes[name_space].back()->declare_function(astnode->identifier, definition);
 	}
 
 }
 
 void Interpreter::visit(std::shared_ptr<ASTLambdaFunction> astnode) {
 	set_curr_pos(astnode->row, astnode->col);
-	const auto& name_space = current_program_stack.top()->name_space;
-
-	// generate an random identifier and evaluates
-	auto& fun = astnode->fun;
+	const auto& current_program = current_program_stack.top();
 
-	auto fun_name = "lambda@" + utils::FlexaUUID::generate();
-	while (scopes[name_space].back()->already_declared_function_name(fun_name)) {
-		fun_name = "lambda@" + utils::FlexaUUID::generate();
+	// every evaluation shares the lambda definition, it's never declared, so its random identifier is only its name
+	if (!astnode->definition) {
+		auto& fun = astnode->fun;
+		astnode->definition = std::make_shared<FunctionDefinition>("lambda@" + utils::FlexaUUID::generate(),
+			fun->type, fun->type_name, fun->type_name_space, fun->array_type, fun->dim, fun->parameters, fun->block,
+			fun->row, fun->col);
 	}
 
-	fun->identifier = fun_name;
-	fun->accept(this);
+	auto definition = astnode->definition;
+	if (auto environment = capture_environment(astnode)) {
+		definition = std::make_shared<FunctionDefinition>(*astnode->definition);
+		definition->environment = environment;
+	}
 
-	current_expression_value = allocate_value(new RuntimeValue(flx_function(name_space, fun->identifier)));
+	current_expression_value = allocate_value(new RuntimeValue(flx_function(current_program->name_space, definition, current_program)));
 }
 
 void Interpreter::visit(std::shared_ptr<ASTBlockNode> astnode) {
@@ -572,10 +964,16 @@ void Interpreter::visit(std::shared_ptr<ASTBlockNode> astnode) {
 	auto current_function_call_name = function_call_name;
 	function_call_name = "";
 
-	scopes[name_space].push_back(std::make_shared<Scope>(current_program, current_function_call_name));
+	// function blocks always have their own scope, it's where returns stop
+	bool has_scope = astnode->declares_symbols || !current_function_call_name.empty()
+		|| !current_function_calling_arguments.empty();
 
-	// declare all parameters in block if its a function
-	declare_function_block_parameters(name_space);
+	if (has_scope) {
+		push_scope(name_space, current_program, current_function_call_name);
+
+		// declare all parameters in block if its a function
+		declare_function_block_parameters(name_space);
+	}
 
 	// executes block 
 	for (auto& stmt : astnode->statements) {
@@ -594,7 +992,7 @@ void Interpreter::visit(std::shared_ptr<ASTBlockNode> astnode) {
 		}
 
 		if (return_from_function) {
-			if (!return_from_function_name.empty() && return_from_function_name == scopes[name_space].back()->name) {
+			if (has_scope && !return_from_function_name.empty() && return_from_function_name == scopes[name_space].back()->name) {
 				return_from_function_name = "";
 				return_from_function = false;
 			}
@@ -602,7 +1000,9 @@ void Interpreter::visit(std::shared_ptr<ASTBlockNode> astnode) {
 		}
 	}
 
-	scopes[name_space].pop_back();
+	if (has_scope) {
+		pop_scope(name_space);
+	}
 	gc.collect();
 }
 
@@ -635,43 +1035,26 @@ void Interpreter::visit(std::shared_ptr<ASTSwitchNode> astnode) {
 
 	++is_switch; // use increment due to nested cases
 
-	scopes[name_space].push_back(std::make_shared<Scope>(current_program));
+	push_scope(name_space, current_program);
 
-	// if it has case blocks we evaluate condition,
-	// if it's not, we don't need do nothing and save cpu
-	if (astnode->case_blocks.size() > 0) {
-		// here it'll validates if matches type
-		astnode->condition->accept(this);
-		TypeDefinition cond_type = *current_expression_value;
-		clear_current_expression();
-
-		// as all cases have same type (guaranted by constant values in semantic analysis),
-		// we just need to evaluate first case to get type
-		for (const auto& expr : astnode->case_blocks) {
-			expr.first->accept(this);
-			break;
+	// case types are checked by semantic analysis, so the condition is just hashed into the jump table
+	astnode->condition->accept(this);
+	size_t pos = astnode->default_block;
+	if (!astnode->parsed_case_blocks.empty()) {
+		if (astnode->check_condition_type && !TypeDefinition::match_type(*current_expression_value, astnode->case_type)) {
+			ExceptionHandler::throw_mismatched_type_err(*current_expression_value, astnode->case_type);
 		}
-		TypeDefinition case_type = *current_expression_value;
-		clear_current_expression();
-
-		if (!TypeDefinition::match_type(cond_type, case_type)) {
-			ExceptionHandler::throw_mismatched_type_err(cond_type, case_type);
+		if (TypeUtils::is_string(astnode->case_type.type)) {
+			pos = find_string_case(astnode, current_expression_value->get_s());
+		}
+		else {
+			pos = astnode->parsed_case_blocks.find(hash(current_expression_value), astnode->default_block);
 		}
 	}
-
-	intmax_t pos;
-	try {
-		// if has and match condition
-		auto hash = astnode->condition->hash(this);
-		pos = astnode->parsed_case_blocks.at(hash);
-	}
-	catch (...) {
-		// else we go to default block
-		pos = astnode->default_block;
-	}
+	clear_current_expression();
 
 	// executes block
-	for (intmax_t i = pos; i < astnode->statements.size(); ++i) {
+	for (size_t i = pos; i < astnode->statements.size(); ++i) {
 		astnode->statements.at(i)->accept(this);
 
 		if (exit_from_program) {
@@ -697,7 +1080,7 @@ void Interpreter::visit(std::shared_ptr<ASTSwitchNode> astnode) {
 		}
 	}
 
-	scopes[name_space].pop_back();
+	pop_scope(name_space);
 	gc.collect();
 	--is_switch;
 }
@@ -762,30 +1145,76 @@ void Interpreter::visit(std::shared_ptr<ASTForNode> astnode) {
 	const auto& name_space = current_program->name_space;
 
 	++is_loop;
-	scopes[name_space].push_back(std::make_shared<Scope>(current_program));
+	push_scope(name_space, current_program);
 
 	// the first statement executes once at start
 	if (astnode->expressions[0]) {
 		astnode->expressions[0]->accept(this);
 	}
 
+	// counted loops compare and step the counter natively while it and its bound are integers
+	const auto& counted = astnode->counted;
+	std::shared_ptr<RuntimeVariable> counter = nullptr;
+	std::shared_ptr<RuntimeVariable> bound_variable = nullptr;
+	std::shared_ptr<ASTLiteralNode<flx_int>> bound_literal = nullptr;
+	if (counted) {
+		counter = std::dynamic_pointer_cast<RuntimeVariable>(scopes[name_space].back()->find_declared_variable(counted->counter));
+		bound_literal = std::dynamic_pointer_cast<ASTLiteralNode<flx_int>>(counted->bound);
+		auto bound_id = std::dynamic_pointer_cast<ASTIdentifierNode>(counted->bound);
+		if (bound_id && bound_id->identifier_vector.size() == 1 && bound_id->identifier_vector[0].access_vector.empty()) {
+			if (const auto& id_scope = get_inner_most_variable_scope(current_program, bound_id->name_space, bound_id->identifier)) {
+				bound_variable = std::dynamic_pointer_cast<RuntimeVariable>(id_scope->find_declared_variable(bound_id->identifier));
+			}
+		}
+	}
+
 	for (;;) {
-		// the second statement executes after each block execution
-		// and defines the condition for executing the block
-		if (astnode->expressions[1]) {
-			astnode->expressions[1]->accept(this);
+		bool result;
+		RuntimeValue* counter_value = counter ? counter->get_value() : nullptr;
+
+		if (counter_value && TypeUtils::is_int(counter_value->type)) {
+			RuntimeValue* bound_value = nullptr;
+			if (!bound_literal) {
+				if (bound_variable) {
+					bound_value = bound_variable->get_value();
+				}
+				else {
+					counted->bound->accept(this);
+					bound_value = current_expression_value;
+					clear_current_expression();
+				}
+			}
 
-			if (!TypeUtils::is_bool(current_expression_value->type)) {
-				ExceptionHandler::throw_condition_type_err();
+			if (bound_literal || TypeUtils::is_int(bound_value->type)) {
+				flx_int bound = bound_literal ? bound_literal->value : bound_value->get_i();
+				flx_int value = counter_value->get_i();
+				result = counted->op == "<" ? value < bound
+					: counted->op == "<=" ? value <= bound
+					: counted->op == ">" ? value > bound
+					: value >= bound;
+			}
+			else {
+				result = allocate_value(RuntimeOperations::do_operation(counted->op, counter_value, bound_value, true))->get_b();
 			}
 		}
 		else {
-			// if empty, execute with no condition
-			current_expression_value = allocate_value(new RuntimeValue(flx_bool(true)));
-		}
+			// the second statement executes after each block execution
+			// and defines the condition for executing the block
+			if (astnode->expressions[1]) {
+				astnode->expressions[1]->accept(this);
 
-		auto result = current_expression_value->get_b();
-		clear_current_expression();
+				if (!TypeUtils::is_bool(current_expression_value->type)) {
+					ExceptionHandler::throw_condition_type_err();
+				}
+			}
+			else {
+				// if empty, execute with no condition
+				current_expression_value = allocate_value(new RuntimeValue(flx_bool(true)));
+			}
+
+			result = current_expression_value->get_b();
+			clear_current_expression();
+		}
 
 		// if result is false
 		if (!result) {
@@ -803,7 +1232,11 @@ void Interpreter::visit(std::shared_ptr<ASTForNode> astnode) {
 		}
 
 		// always execute after the block
-		if (astnode->expressions[2]) {
+		counter_value = counter ? counter->get_value() : nullptr;
+		if (counter_value && TypeUtils::is_int(counter_value->type)) {
+			*counter_value->get_raw_i() += counted->step;
+		}
+		else if (astnode->expressions[2]) {
 			astnode->expressions[2]->accept(this);
 		}
 
@@ -817,7 +1250,7 @@ void Interpreter::visit(std::shared_ptr<ASTForNode> astnode) {
 		}
 	}
 
-	scopes[name_space].pop_back();
+	pop_scope(name_space);
 	gc.collect();
 	--is_loop;
 }
@@ -832,171 +1265,204 @@ void Interpreter::visit(std::shared_ptr<ASTForEachNode> astnode) {
 	// stores colection at current_expression_value 
 	astnode->collection->accept(this);
 
-	// adds a meta scope, to store current collection value
-	scopes[name_space].push_back(std::make_shared<Scope>(current_program));
-
-	switch (current_expression_value->type) {
-	case Type::T_ARRAY: { // if the collection is an array
-		auto colletion = current_expression_value->get_arr();
-		clear_current_expression();
-		auto root_colletion = std::make_shared<flx_array>(colletion);
-		gc.add_array_root(root_colletion);
+	auto coll_expr = current_expression_value;
+	clear_current_expression();
+	// the container expires if the body throws, so the collection is not left rooted
+	auto coll_root = std::make_shared<std::vector<RuntimeValue*>>(1, coll_expr);
+	gc.add_root_container(coll_root);
 
-		for (size_t i = 0; i < colletion.size(); ++i) {
-			auto exnode = std::make_shared<ASTValueNode>(colletion[i], astnode->row, astnode->col);
+	// adds a meta scope, to store current collection value
+	push_scope(name_space, current_program);
+
+	// the loop variable is declared once and rebound at each iteration,
+	// nodes used to assign existing variables are built once per loop
+	const auto itdecl = std::dynamic_pointer_cast<ASTDeclarationNode>(astnode->itdecl);
+	const auto itid = std::dynamic_pointer_cast<ASTIdentifierNode>(astnode->itdecl);
+	std::shared_ptr<RuntimeVariable> itvar = nullptr;
+	std::vector<size_t> itdim;
+	RuntimeValue* itvalue = nullptr;
+	auto exnode = std::make_shared<ASTValueNode>(nullptr, astnode->row, astnode->col);
+	std::shared_ptr<ASTAssignmentNode> assign_node = nullptr;
+
+	if (itdecl) {
+		itdim = evaluate_access_vector(itdecl->expr_dim);
+		itvar = std::make_shared<RuntimeVariable>(itdecl->identifier, itdecl->type,
+			itdecl->array_type, itdim,
+			itdecl->type_name, itdecl->type_name_space);
+		gc.add_var_root(itvar);
+		scopes[name_space].back()->declare_variable(itdecl->identifier, itvar);
+	}
+	else if (itid) {
+		assign_node = std::make_shared<ASTAssignmentNode>(itid->identifier_vector, itid->name_space, "=", exnode, itid->row, itid->col);
+	}
+
+	auto bind = [&](RuntimeValue* value) {
+		if (itvar) {
+			bind_foreach_variable(itvar, itdecl, itdim, value, itvalue);
+		}
+		else if (assign_node) {
+			exnode->value = value;
+			assign_node->accept(this);
+		}
+	};
 
-			// declare each value at meta block
-			if (auto itdecl = std::dynamic_pointer_cast<ASTDeclarationNode>(astnode->itdecl)) {
-				itdecl->expr = exnode;
-				itdecl->accept(this);
-				itdecl->expr = nullptr;
+	// returns true if the loop must stop
+	auto run_block = [&]() {
+		astnode->block->accept(this);
 
-			}
-			else if (auto itdecl = std::dynamic_pointer_cast<ASTIdentifierNode>(astnode->itdecl)) {
-				auto assign_node = std::make_shared<ASTAssignmentNode>(itdecl->identifier_vector, itdecl->name_space, "=", exnode, itdecl->row, itdecl->col);
-				assign_node->accept(this);
+		if (exit_from_program) {
+			return true;
+		}
 
-			}
+		if (continue_block) {
+			continue_block = false;
+			return false;
+		}
 
-			astnode->block->accept(this);
+		if (break_block) {
+			break_block = false;
+			return true;
+		}
 
-			if (exit_from_program) {
-				return;
-			}
+		return return_from_function;
+	};
 
-			if (continue_block) {
-				continue_block = false;
-				continue;
-			}
+	switch (coll_expr->type) {
+	case Type::T_ARRAY: { // if the collection is an array
+		// roots the iterated elements, in case the collection value is replaced by the block
+		auto colletion = std::make_shared<flx_array>(coll_expr->get_arr());
+		gc.add_array_root(colletion);
 
-			if (break_block) {
-				break_block = false;
-				break;
-			}
+		for (size_t i = 0; i < colletion->size(); ++i) {
+			bind((*colletion)[i]);
 
-			if (return_from_function) {
+			if (run_block()) {
 				break;
 			}
 		}
 
-		gc.add_array_root(root_colletion);
+		gc.remove_array_root(colletion);
 
 		break;
 	}
 	case Type::T_STRING: { // if the collection is a string
-		auto colletion = current_expression_value->get_s();
-		clear_current_expression();
+		const auto colletion = coll_expr->get_s();
 
 		for (auto val : colletion) {
-			auto exnode = std::make_shared<ASTValueNode>(allocate_value(new RuntimeValue(flx_char(val))), astnode->row, astnode->col);
-
-			// declare each value at meta block
-			if (auto itdecl = std::dynamic_pointer_cast<ASTDeclarationNode>(astnode->itdecl)) {
-				itdecl->expr = exnode;
-				itdecl->accept(this);
-				itdecl->expr = nullptr;
-
+			// chars are written into the loop variable value while the loop owns it
+			if (itvar && itvalue && itvar->get_value() == itvalue && !itvalue->use_ref && TypeUtils::is_char(itvalue->type)) {
+				*itvalue->get_raw_c() = val;
 			}
-			else if (auto itdecl = std::dynamic_pointer_cast<ASTIdentifierNode>(astnode->itdecl)) {
-				auto assign_node = std::make_shared<ASTAssignmentNode>(itdecl->identifier_vector, itdecl->name_space, "=", exnode, itdecl->row, itdecl->col);
-				assign_node->accept(this);
-
-			}
-
-			astnode->block->accept(this);
-
-			if (exit_from_program) {
-				return;
-			}
-
-			if (continue_block) {
-				continue_block = false;
-				continue;
-			}
-
-			if (break_block) {
-				break_block = false;
-				break;
+			else {
+				bind(allocate_value(new RuntimeValue(flx_char(val))));
 			}
 
-			if (return_from_function) {
+			if (run_block()) {
 				break;
 			}
 		}
+
 		break;
 	}
 	case Type::T_STRUCT: { // if the collection is a struct
-		auto coll_expr = current_expression_value;
-		clear_current_expression();
-		gc.add_ptr_root(&coll_expr);
-
 		const auto& colletion = coll_expr->get_str();
 
+		// pairs are built by a constructor node reused across iterations, so its prototype is cached
+		auto key = std::make_shared<ASTLiteralNode<flx_string>>(flx_string(), astnode->row, astnode->col);
+		auto value = std::make_shared<ASTValueNode>(nullptr, astnode->row, astnode->col);
+		std::map<std::string, std::shared_ptr<ASTExprNode>> values = { { "key", key }, { "value", value } };
+		auto pair_node = std::make_shared<ASTStructConstructorNode>("Pair", Constants::STD_NAMESPACE, values, astnode->row, astnode->col);
+		const auto unpacked = std::dynamic_pointer_cast<ASTUnpackedDeclarationNode>(astnode->itdecl);
+
+		// expect a 2 sized unpacked declaration
+		if (unpacked && unpacked->declarations.size() != 2) {
+			throw std::runtime_error("invalid number of values");
+		}
+
 		for (const auto& val : colletion) {
-			auto key = std::make_shared<ASTLiteralNode<flx_string>>(flx_string(val.first), astnode->row, astnode->col);
-			auto value = std::make_shared<ASTValueNode>(val.second, astnode->row, astnode->col);
+			key->value = val.first;
+			value->value = val.second;
 
 			// when handling structs, we have a third type of declaration: unpacked declaration
-			if (auto itdecl = std::dynamic_pointer_cast<ASTDeclarationNode>(astnode->itdecl)) {
-				std::map<std::string, std::shared_ptr<ASTExprNode>> values = { { "key", key }, { "value", value } };
-				auto exnode = std::make_shared<ASTStructConstructorNode>("Pair", Constants::STD_NAMESPACE, values, astnode->row, astnode->col);
-				itdecl->expr = exnode;
-				itdecl->accept(this);
-				itdecl->expr = nullptr;
-
+			if (unpacked) {
+				unpacked->declarations[0]->expr = key;
+				unpacked->declarations[1]->expr = value;
+				unpacked->accept(this);
+				unpacked->declarations[0]->expr = nullptr;
+				unpacked->declarations[1]->expr = nullptr;
 			}
-			else if (auto itdecl = std::dynamic_pointer_cast<ASTIdentifierNode>(astnode->itdecl)) {
-				std::map<std::string, std::shared_ptr<ASTExprNode>> values = { { "key", key }, { "value", value } };
-				auto exnode = std::make_shared<ASTStructConstructorNode>("Pair", Constants::STD_NAMESPACE, values, astnode->row, astnode->col);
-				auto assign_node = std::make_shared<ASTAssignmentNode>(itdecl->identifier_vector, itdecl->name_space, "=", exnode, itdecl->row, itdecl->col);
-				assign_node->accept(this);
-
+			else {
+				pair_node->accept(this);
+				auto pair = current_expression_value;
+				clear_current_expression();
+				bind(pair);
 			}
-			else if (const auto idnode = std::dynamic_pointer_cast<ASTUnpackedDeclarationNode>(astnode->itdecl)) {
-				// expect a 2 sized unpacked declaration
-				if (idnode->declarations.size() != 2) {
-					throw std::runtime_error("invalid number of values");
-				}
 
-				idnode->declarations[0]->expr = key;
-				idnode->declarations[1]->expr = value;
-				idnode->accept(this);
-				idnode->declarations[0]->expr = nullptr;
-				idnode->declarations[1]->expr = nullptr;
+			if (run_block()) {
+				break;
 			}
+		}
 
-			astnode->block->accept(this);
+		break;
+	}
+	default:
+		throw std::runtime_error("invalid foreach iterable type");
+	}
 
-			if (exit_from_program) {
-				return;
-			}
+	gc.remove_root_container(coll_root);
 
-			if (continue_block) {
-				continue_block = false;
-				continue;
-			}
+	pop_scope(name_space);
+	gc.collect();
+	--is_loop;
+}
 
-			if (break_block) {
-				break_block = false;
-				break;
-			}
+void Interpreter::bind_foreach_variable(std::shared_ptr<RuntimeVariable> var, std::shared_ptr<ASTDeclarationNode> itdecl,
+	const std::vector<size_t>& dim, RuntimeValue* value, RuntimeValue*& owned) {
+	RuntimeValue* new_value = value;
 
-			if (return_from_function) {
+	if (!value->use_ref) {
+		// primitives are written into the value of the previous iteration while nothing else references it
+		if (owned && var->get_value() == owned && !owned->use_ref && owned->type == value->type) {
+			switch (value->type) {
+			case Type::T_BOOL:
+				*owned->get_raw_b() = value->get_b();
+				return;
+			case Type::T_INT:
+				*owned->get_raw_i() = value->get_i();
+				return;
+			case Type::T_FLOAT:
+				*owned->get_raw_f() = value->get_f();
+				return;
+			case Type::T_CHAR:
+				*owned->get_raw_c() = value->get_c();
+				return;
+			default:
 				break;
 			}
 		}
 
-		gc.remove_ptr_root(&coll_expr);
+		new_value = allocate_value(new RuntimeValue(value));
+		owned = new_value;
+	}
 
-		break;
+	if (!dim.empty()) {
+		check_build_array(new_value, dim);
 	}
-	default:
-		throw std::runtime_error("invalid foreach iterable type");
+
+	var->set_value(new_value);
+
+	// validate assignment type
+	if ((!TypeDefinition::is_any_or_match_type(*var, *new_value) ||
+		(TypeUtils::is_array(var->type) && !TypeUtils::is_any(var->array_type)
+		&& !TypeDefinition::match_type(*var, *new_value, false, true)))
+		&& !TypeUtils::is_undefined(new_value->type) && !TypeUtils::is_array(new_value->type)) {
+		ExceptionHandler::throw_declaration_type_err(itdecl->identifier, *var, *new_value);
 	}
 
-	scopes[name_space].pop_back();
-	gc.collect();
-	--is_loop;
+	validates_reference_type_assignment(*var, new_value);
+
+	// normalize string and number types
+	RuntimeOperations::normalize_type(var.get(), new_value);
 }
 
 void Interpreter::visit(std::shared_ptr<ASTTryCatchNode> astnode) {
@@ -1004,48 +1470,106 @@ void Interpreter::visit(std::shared_ptr<ASTTryCatchNode> astnode) {
 	const auto& current_program = current_program_stack.top();
 	const auto& name_space = current_program->name_space;
 
-	try {
-		scopes[name_space].push_back(std::make_shared<Scope>(current_program));
+	// calls left by the error restore themselves, blocks of this function are unwound here
+	size_t try_scopes = scopes[name_space].size();
+	size_t try_is_loop = is_loop;
+	size_t try_is_switch = is_switch;
 
+	// the try block opens its own scope when it declares something, so entering it costs nothing
+	try {
 		astnode->try_block->accept(this);
+	}
+	catch (const std::runtime_error& ex) {
+		while (scopes[name_space].size() > try_scopes) {
+			pop_scope(name_space);
+		}
+		is_loop = try_is_loop;
+		is_switch = try_is_switch;
 
-		scopes[name_space].pop_back();
+		if (std::dynamic_pointer_cast<ASTEllipsisNode>(astnode->decl)) {
+			if (const auto thrown = dynamic_cast<const ThrownError*>(&ex)) {
+				gc.remove_root(thrown->value);
+			}
+			gc.collect();
+
+			astnode->catch_block->accept(this);
+			return;
+		}
+
+		push_scope(name_space, current_program);
+
+		bind_caught_error(astnode->decl, ex);
 		gc.collect();
-	}
-	catch (std::runtime_error ex) {
-		scopes[name_space].pop_back();
+
+		astnode->catch_block->accept(this);
+		pop_scope(name_space);
 		gc.collect();
 
-		scopes[name_space].push_back(std::make_shared<Scope>(current_program));
+	}
 
-		auto error_node = std::make_shared<ASTLiteralNode<flx_string>>(ex.what(), astnode->row, astnode->col);
-		auto code_node = std::make_shared<ASTLiteralNode<flx_int>>(0, astnode->row, astnode->col);
+}
 
-		// another place we can use unpacked declaration
-		if (const auto idnode = std::dynamic_pointer_cast<ASTUnpackedDeclarationNode>(astnode->decl)) {
-			idnode->declarations[0]->expr = error_node;
-			idnode->declarations[1]->expr = code_node;
-			idnode->accept(this);
-			idnode->declarations[0]->expr = nullptr;
-			idnode->declarations[1]->expr = nullptr;
-		}
-		else if (const auto idnode = std::dynamic_pointer_cast<ASTDeclarationNode>(astnode->decl)) {
-			std::map<std::string, std::shared_ptr<ASTExprNode>> values = { { "error", error_node }, { "code", code_node } };
-			auto exnode = std::make_shared<ASTStructConstructorNode>("Exception", Constants::STD_NAMESPACE, values, astnode->row, astnode->col);
-			idnode->expr = exnode;
-			idnode->accept(this);
-			idnode->expr = nullptr;
-		}
-		else if (!std::dynamic_pointer_cast<ASTEllipsisNode>(astnode->decl)) {
-			throw std::runtime_error("expected declaration");
+void Interpreter::bind_caught_error(std::shared_ptr<ASTNode> decl, const std::runtime_error& ex) {
+	const auto thrown = dynamic_cast<const ThrownError*>(&ex);
+	RuntimeValue* thrown_struct = thrown && TypeUtils::is_struct(thrown->value->type) ? thrown->value : nullptr;
+
+	// another place we can use unpacked declaration
+	if (const auto idnode = std::dynamic_pointer_cast<ASTUnpackedDeclarationNode>(decl)) {
+		RuntimeValue* code = thrown_struct && thrown_struct->get_str().contains("code") ? thrown_struct->find_sub("code") : nullptr;
+		declare_value(idnode->declarations[0], allocate_value(new RuntimeValue(flx_string(ex.what()))), true);
+		declare_value(idnode->declarations[1], code ? deep_copy_value(code) : allocate_value(new RuntimeValue(flx_int(0))), true);
+	}
+	// thrown exceptions are bound as a copy, other errors are wrapped in a new one
+	else if (const auto idnode = std::dynamic_pointer_cast<ASTDeclarationNode>(decl)) {
+		RuntimeValue* exception_value = thrown_struct ? deep_copy_value(thrown_struct) : nullptr;
+		if (!exception_value) {
+			const auto& type_struct = find_inner_most_struct(current_program_stack.top(), Constants::STD_NAMESPACE, "Exception");
+			auto str = flx_struct(type_struct.shape);
+			for (const auto& [identifier, variable] : type_struct.variables) {
+				RuntimeValue* str_value = allocate_value(new RuntimeValue(variable.type));
+				str_value->set_null();
+				str[identifier] = str_value;
+			}
+			str["error"] = allocate_value(new RuntimeValue(flx_string(ex.what())));
+			if (str.contains("code")) {
+				str["code"] = allocate_value(new RuntimeValue(flx_int(0)));
+			}
+			exception_value = allocate_value(new RuntimeValue(str, "Exception", Constants::STD_NAMESPACE));
 		}
+		declare_value(idnode, exception_value, true);
+	}
+	else {
+		throw std::runtime_error("expected declaration");
+	}
 
-		astnode->catch_block->accept(this);
-		scopes[name_space].pop_back();
-		gc.collect();
+	// the thrown value is held by the declaration now
+	if (thrown) {
+		gc.remove_root(thrown->value);
+	}
+}
+
+RuntimeValue* Interpreter::deep_copy_value(RuntimeValue* value) {
+	auto copy = allocate_value(new RuntimeValue(value));
 
+	if (TypeUtils::is_struct(copy->type)) {
+		auto str = copy->get_raw_str();
+		for (size_t i = 0; i < str->size(); ++i) {
+			if (str->slot(i)) {
+				str->slot(i) = deep_copy_value(str->slot(i));
+			}
+		}
+	}
+	else if (TypeUtils::is_array(copy->type)) {
+		// array copies share their items storage, so the items are moved to a new one
+		auto& items = *value->get_raw_arr();
+		auto arr = flx_array(items.size());
+		for (size_t i = 0; i < items.size(); ++i) {
+			arr[i] = items[i] ? deep_copy_value(items[i]) : nullptr;
+		}
+		*copy->get_raw_arr() = arr;
 	}
 
+	return copy;
 }
 
 void Interpreter::visit(std::shared_ptr<ASTThrowNode> astnode) {
@@ -1063,17 +1587,16 @@ void Interpreter::visit(std::shared_ptr<ASTThrowNode> astnode) {
 			|| throw_expression->type_name_space != Constants::STD_NAMESPACE) {
 			throw std::runtime_error("expected flx::Exception not " + TypeDefinition::buid_type_str(*throw_expression));
 		}
-
-		throw std::runtime_error(throw_expression->get_str()["error"]->get_s().c_str());
 	}
 	// handle bare string
-	else if (TypeUtils::is_string(throw_expression->type)) {
-		throw std::runtime_error(throw_expression->get_s());
-	}
-	else {
+	else if (!TypeUtils::is_string(throw_expression->type)) {
 		throw std::runtime_error("expected flx::Exception struct or string in throw");
 	}
 
+	// the value itself is thrown, its message is only read if it's reported
+	gc.add_root(throw_expression);
+	throw ThrownError(throw_expression);
+
 }
 
 void Interpreter::visit(std::shared_ptr<ASTEllipsisNode> astnode) {
@@ -1295,16 +1818,19 @@ void Interpreter::visit(std::shared_ptr<ASTStructConstructorNode> astnode) {
 	const auto& current_program = current_program_stack.top();
 	const auto& name_space = astnode->name_space;
 
-	auto type_struct = find_inner_most_struct(current_program, name_space, astnode->type_name);
+	const auto& type_struct = find_inner_most_struct(current_program, name_space, astnode->type_name);
+
+	if (!astnode->prototype || astnode->prototype->definition_id != type_struct.id) {
+		astnode->prototype = build_struct_prototype(astnode, type_struct);
+	}
+	// keeps the prototype alive if a nested evaluation rebuilds it
+	auto prototype = astnode->prototype;
 
-	auto str = flx_struct();
+	auto str = flx_struct(type_struct.shape);
 
+	size_t value_index = 0;
 	for (auto& expr : astnode->values) {
-		// check it is a member
-		if (type_struct.variables.find(expr.first) == type_struct.variables.end()) {
-			ExceptionHandler::throw_struct_member_err(name_space, astnode->type_name, expr.first);
-		}
-		VariableDefinition var_type_struct = type_struct.variables[expr.first];
+		const auto& [slot, var_type_struct] = prototype->values[value_index++];
 
 		expr.second->accept(this);
 
@@ -1321,7 +1847,9 @@ void Interpreter::visit(std::shared_ptr<ASTStructConstructorNode> astnode) {
 			str_value = allocate_value(new RuntimeValue(str_value));
 		}
 
-		check_build_array(str_value, evaluate_access_vector(var_type_struct.expr_dim));
+		if (!var_type_struct.expr_dim.empty()) {
+			check_build_array(str_value, evaluate_access_vector(var_type_struct.expr_dim));
+		}
 		validates_reference_type_assignment(var_type_struct, str_value);
 		RuntimeOperations::normalize_type(&var_type_struct, str_value);
 
@@ -1332,16 +1860,14 @@ void Interpreter::visit(std::shared_ptr<ASTStructConstructorNode> astnode) {
 			str_value->type_name_space = var_type_struct.type_name_space;
 		}
 
-		str[expr.first] = str_value;
+		str.slot(slot) = str_value;
 	}
 
 	// declare rest values as null
-	for (auto& struct_var_def : type_struct.variables) {
-		if (str.find(struct_var_def.first) == str.end()) {
-			RuntimeValue* str_value = allocate_value(new RuntimeValue(struct_var_def.second.type));
-			str_value->set_null();
-			str[struct_var_def.first] = str_value;
-		}
+	for (const auto& [slot, type] : prototype->defaults) {
+		RuntimeValue* str_value = allocate_value(new RuntimeValue(type));
+		str_value->set_null();
+		str.slot(slot) = str_value;
 	}
 
 	current_expression_value = allocate_value(new RuntimeValue(str, astnode->type_name, name_space));
@@ -1356,6 +1882,14 @@ void Interpreter::visit(std::shared_ptr<ASTIdentifierNode> astnode) {
 	// handle regular identifier
 	if (const auto& id_scope = get_inner_most_variable_scope(current_program, name_space, astnode->identifier)) {
 		auto variable = std::dynamic_pointer_cast<RuntimeVariable>(id_scope->find_declared_variable(astnode->identifier));
+
+		// plain variable read, there is nothing to access
+		if (astnode->identifier_vector.size() == 1 && astnode->identifier_vector[0].access_vector.empty()) {
+			current_expression_value = variable->get_value();
+			current_expression_value->reset_ref();
+			return;
+		}
+
 		auto sub_val = access_value(variable->get_value(), astnode->identifier_vector);
 		sub_val->reset_ref();
 
@@ -1363,11 +1897,11 @@ void Interpreter::visit(std::shared_ptr<ASTIdentifierNode> astnode) {
 
 		if (current_expression_value->type == Type::T_STRING && astnode->identifier_vector.back().access_vector.size() > 0 && has_string_access) {
 			has_string_access = false;
-			auto str = current_expression_value->get_s();
 			std::dynamic_pointer_cast<ASTExprNode>(astnode->identifier_vector.back().access_vector[astnode->identifier_vector.back().access_vector.size() - 1])->accept(this);
 			auto pos = current_expression_value->get_i();
+			check_string_position(sub_val, pos);
 
-			auto char_value = allocate_value(new RuntimeValue(flx_char(str[pos])));
+			auto char_value = allocate_value(new RuntimeValue(flx_char(sub_val->get_sv()[pos])));
 			char_value->value_ref = sub_val;
 			char_value->access_index = pos;
 			current_expression_value = char_value;
@@ -1393,8 +1927,11 @@ void Interpreter::visit(std::shared_ptr<ASTIdentifierNode> astnode) {
 
 	}
 	// handle expression function calls
-	else if (get_inner_most_function_scope(current_program, name_space, astnode->identifier, nullptr)) {
-		auto fun = flx_function{ name_space, astnode->identifier };
+	else if (auto func_scope = get_inner_most_function_scope(current_program, name_space, astnode->identifier, nullptr)) {
+		// a single declaration is kept as the value handle, so calling it skips the lookup
+		auto funcs = func_scope->find_declared_functions(astnode->identifier);
+		auto handle = funcs->size() == 1 ? &funcs->front() : nullptr;
+		auto fun = flx_function{ name_space, astnode->identifier, func_scope, handle };
 		current_expression_value = allocate_value(new RuntimeValue(fun));
 
 	}
@@ -1413,6 +1950,12 @@ void Interpreter::visit(std::shared_ptr<ASTBinaryExprNode> astnode) {
 	RuntimeValue* l_value = current_expression_value;
 	clear_current_expression();
 
+	if (!l_value->use_ref && l_value->type == astnode->operand_type
+		&& (TypeUtils::is_int(l_value->type) || TypeUtils::is_float(l_value->type))) {
+		typed_binary_operation(astnode, l_value);
+		return;
+	}
+
 	if (!l_value->use_ref) {
 		l_value = allocate_value(new RuntimeValue(l_value));
 	}
@@ -1428,15 +1971,71 @@ void Interpreter::visit(std::shared_ptr<ASTBinaryExprNode> astnode) {
 	RuntimeValue* r_value = current_expression_value;
 	clear_current_expression();
 
+	binary_operation(astnode, l_value, r_value);
+}
+
+void Interpreter::typed_binary_operation(std::shared_ptr<ASTBinaryExprNode> astnode, RuntimeValue* l_value) {
+	// the left operand is kept natively, so it is only copied if the generic operation is needed
+	Type type = l_value->type;
+	bool is_int = TypeUtils::is_int(type);
+	flx_int l_int = is_int ? l_value->get_i() : 0;
+	flx_float l_float = is_int ? 0 : l_value->get_f();
+	auto l_ref = l_value->ref;
+
+	astnode->right->accept(this);
+	RuntimeValue* r_value = current_expression_value;
+	clear_current_expression();
+
+	RuntimeValue* res_value = nullptr;
+	if (r_value->type == type) {
+		res_value = is_int ? RuntimeOperations::do_typed_operation(astnode->op, l_int, r_value->get_i())
+			: RuntimeOperations::do_typed_operation(astnode->op, l_float, r_value->get_f());
+	}
+
+	if (res_value) {
+		// arithmetic results keep the left variable as the generic operation does
+		if (res_value->type == type) {
+			res_value->ref = l_ref;
+		}
+		current_expression_value = allocate_value(res_value);
+		return;
+	}
+
+	gc.add_root(r_value);
+	l_value = allocate_value(is_int ? new RuntimeValue(l_int) : new RuntimeValue(l_float));
+	l_value->ref = l_ref;
+	gc.add_root(l_value);
+	gc.remove_root(r_value);
+
+	binary_operation(astnode, l_value, r_value);
+}
+
+void Interpreter::binary_operation(std::shared_ptr<ASTBinaryExprNode> astnode, RuntimeValue* l_value, RuntimeValue* r_value) {
+	// l_value is expected to be already rooted
 	if (!r_value->use_ref) {
 		r_value = allocate_value(new RuntimeValue(r_value));
 	}
 	gc.add_root(r_value);
 
-	current_expression_value = RuntimeOperations::do_operation(astnode->op, l_value, r_value, true);
+	if (astnode->operand_type == Type::T_STRING && TypeUtils::is_string(l_value->type) && TypeUtils::is_string(r_value->type)
+		&& !l_value->use_ref && (astnode->op == "+" || Token::is_equality_op(astnode->op))) {
+		if (astnode->op == "+") {
+			flx_string res;
+			res.reserve(l_value->get_sv().size() + r_value->get_sv().size());
+			res.append(l_value->get_sv()).append(r_value->get_sv());
+			l_value->set(std::move(res));
+			current_expression_value = l_value;
+		}
+		else {
+			current_expression_value = allocate_value(new RuntimeValue(flx_bool((l_value->get_sv() == r_value->get_sv()) == (astnode->op == "=="))));
+		}
+	}
+	else {
+		current_expression_value = RuntimeOperations::do_operation(astnode->op, l_value, r_value, true);
 
-	if (current_expression_value != l_value && current_expression_value != r_value) {
-		allocate_value(current_expression_value);
+		if (current_expression_value != l_value && current_expression_value != r_value) {
+			allocate_value(current_expression_value);
+		}
 	}
 
 	gc.remove_root(l_value);
@@ -1468,37 +2067,30 @@ void Interpreter::visit(std::shared_ptr<ASTInNode> astnode) {
 
 	astnode->value->accept(this);
 
-	RuntimeValue expr_val = RuntimeValue(current_expression_value);
+	// operands are only read, so they are rooted instead of copied
+	RuntimeValue* expr_val = current_expression_value;
 	clear_current_expression();
+	gc.add_root(expr_val);
 
 	astnode->collection->accept(this);
 
-	RuntimeValue coll_val = RuntimeValue(current_expression_value);
+	RuntimeValue* coll_val = current_expression_value;
 	clear_current_expression();
 
 	bool res = false;
 
-	if (TypeUtils::is_array(coll_val.type)) {
-		flx_array expr_col = coll_val.get_arr();
-
-		for (size_t i = 0; i < expr_col.size(); ++i) {
-			res = RuntimeOperations::equals_value(&expr_val, expr_col[i]);
-			if (res) {
-				break;
-			}
-		}
+	if (TypeUtils::is_array(coll_val->type)) {
+		res = RuntimeOperations::contains_value(coll_val->get_arr(), expr_val);
+	}
+	else if (TypeUtils::is_char(expr_val->type)) {
+		res = utils::StringUtils::find(coll_val->get_sv(), expr_val->get_c()) != std::string_view::npos;
 	}
 	else {
-		const auto& expr_col = coll_val.get_s();
-
-		if (TypeUtils::is_char(expr_val.type)) {
-			res = coll_val.get_s().find(expr_val.get_c()) != std::string::npos;
-		}
-		else {
-			res = coll_val.get_s().find(expr_val.get_s()) != std::string::npos;
-		}
+		res = utils::StringUtils::find(coll_val->get_sv(), expr_val->get_sv()) != std::string_view::npos;
 	}
 
+	gc.remove_root(expr_val);
+
 	current_expression_value = allocate_value(new RuntimeValue(flx_bool(res)));
 }
 
@@ -1802,7 +2394,9 @@ RuntimeValue* Interpreter::set_value(std::shared_ptr<RuntimeVariable> var, const
 
 				// break if it is a string, and the string access will be handled in identifier node evaluation
 				if (TypeUtils::is_string((*current_val)[access_pos]->type)) {
-					(*current_val)[access_pos]->get_s()[access_vector.at(s + 1)] = new_value->get_c();
+					has_string_access = false;
+					check_string_position((*current_val)[access_pos], access_vector.at(s + 1));
+					(*(*current_val)[access_pos]->get_raw_s())[access_vector.at(s + 1)] = new_value->get_c();
 					return (*current_val)[access_pos];
 				}
 				if (access_pos >= current_val->size()) {
@@ -1811,7 +2405,9 @@ RuntimeValue* Interpreter::set_value(std::shared_ptr<RuntimeVariable> var, const
 				current_val = (*current_val)[access_pos]->get_raw_arr();
 			}
 			if (TypeUtils::is_string(value->type)) {
-				value->get_s()[access_vector.at(s)] = new_value->get_c();
+				has_string_access = false;
+				check_string_position(value, access_vector.at(s));
+				(*value->get_raw_s())[access_vector.at(s)] = new_value->get_c();
 				return value;
 			}
 			access_pos = access_vector.at(s);
@@ -1838,10 +2434,10 @@ RuntimeValue* Interpreter::set_value(std::shared_ptr<RuntimeVariable> var, const
 			}
 
 			if (i == identifier_vector.size() - 1 && identifier_vector[i].access_vector.size() == 0) {
-				value->set_sub(identifier_vector[i].identifier, new_value);
+				value->set_sub(identifier_vector[i].identifier, new_value, identifier_vector[i].slot);
 			}
 			else {
-				value = value->get_str()[identifier_vector[i].identifier];
+				value = value->get_sub(identifier_vector[i].identifier, identifier_vector[i].slot);
 			}
 		}
 	}
@@ -1894,11 +2490,12 @@ RuntimeValue* Interpreter::access_value(RuntimeValue* value, const std::vector<I
 			throw std::runtime_error("cannot reach '" + ss.str() + "', previous '" + identifier_vector[i - 1].identifier + "' value is null");
 		}
 
-		if (!next_value->get_str().contains(identifier_vector[i].identifier)) {
-			ExceptionHandler::throw_struct_member_err(next_value->type_name_space, next_value->type_name, identifier_vector[i].identifier);
+		const auto& identifier = identifier_vector[i];
+		if (next_value->get_str().index_of(identifier.identifier, identifier.slot) == StructShape::npos) {
+			ExceptionHandler::throw_struct_member_err(next_value->type_name_space, next_value->type_name, identifier.identifier);
 		}
 
-		next_value = next_value->get_sub(identifier_vector[i].identifier);
+		next_value = next_value->get_sub(identifier.identifier, identifier.slot);
 
 		if (identifier_vector[i].access_vector.size() > 0 || i < identifier_vector.size()) {
 			return access_value(next_value, identifier_vector, i);
@@ -1940,6 +2537,31 @@ std::shared_ptr<Scope> Interpreter::find_declared_function_strict(const std::sha
 
 }
 
+size_t Interpreter::find_string_case(std::shared_ptr<ASTSwitchNode> astnode, flx_string value) {
+	auto range = astnode->parsed_case_blocks.string_blocks.equal_range(hash_string(value));
+	for (auto it = range.first; it != range.second; ++it) {
+		const auto& [expr, pos] = it->second;
+		// literal cases are compared directly, other constants are evaluated
+		if (auto literal = std::dynamic_pointer_cast<ASTLiteralNode<flx_string>>(expr)) {
+			if (literal->value == value) {
+				return pos;
+			}
+			continue;
+		}
+		expr->accept(this);
+		if (current_expression_value->get_s() == value) {
+			return pos;
+		}
+	}
+	return astnode->default_block;
+}
+
+void Interpreter::check_string_position(RuntimeValue* value, intmax_t pos) {
+	if (pos < 0 || static_cast<size_t>(pos) >= value->get_sv().size()) {
+		throw std::runtime_error("invalid string position access");
+	}
+}
+
 intmax_t Interpreter::hash(RuntimeValue* value) {
 	switch (value->type) {
 	case Type::T_BOOL:
@@ -1947,11 +2569,11 @@ intmax_t Interpreter::hash(RuntimeValue* value) {
 	case Type::T_INT:
 		return static_cast<intmax_t>(value->get_i());
 	case Type::T_FLOAT:
-		return static_cast<intmax_t>(value->get_f());
+		return hash_float(value->get_f());
 	case Type::T_CHAR:
 		return static_cast<intmax_t>(value->get_c());
 	case Type::T_STRING:
-		return utils::StringUtils::hashcode(value->get_s());
+		return hash_string(value->get_sv());
 	default:
 		throw std::runtime_error("cannot determine type");
 	}
@@ -1975,7 +2597,7 @@ intmax_t Interpreter::hash(std::shared_ptr<ASTLiteralNode<flx_int>> astnode) {
 }
 
 intmax_t Interpreter::hash(std::shared_ptr<ASTLiteralNode<flx_float>> astnode) {
-	return static_cast<intmax_t>(astnode->value);
+	return hash_float(astnode->value);
 }
 
 intmax_t Interpreter::hash(std::shared_ptr<ASTLiteralNode<flx_char>> astnode) {
@@ -1983,7 +2605,7 @@ intmax_t Interpreter::hash(std::shared_ptr<ASTLiteralNode<flx_char>> astnode) {
 }
 
 intmax_t Interpreter::hash(std::shared_ptr<ASTLiteralNode<flx_string>> astnode) {
-	return utils::StringUtils::hashcode(astnode->value);
+	return hash_string(astnode->value);
 }
 
 intmax_t Interpreter::hash(std::shared_ptr<ASTIdentifierNode> astnode) {
@@ -1995,6 +2617,33 @@ intmax_t Interpreter::hash(std::shared_ptr<ASTIdentifierNode> astnode) {
 	return hash(value);
 }
 
+std::shared_ptr<StructConstructorPrototype> Interpreter::build_struct_prototype(std::shared_ptr<ASTStructConstructorNode> astnode, const StructureDefinition& type_struct) {
+	auto prototype = std::make_shared<StructConstructorPrototype>();
+	prototype->definition_id = type_struct.id;
+
+	std::vector<bool> provided(type_struct.shape->size(), false);
+
+	for (const auto& expr : astnode->values) {
+		// check it is a member
+		auto var_type_struct = type_struct.variables.find(expr.first);
+		if (var_type_struct == type_struct.variables.end()) {
+			ExceptionHandler::throw_struct_member_err(astnode->name_space, astnode->type_name, expr.first);
+		}
+		size_t slot = type_struct.shape->index_of(expr.first);
+		provided[slot] = true;
+		prototype->values.emplace_back(slot, var_type_struct->second);
+	}
+
+	for (const auto& var : type_struct.variables) {
+		size_t slot = type_struct.shape->index_of(var.first);
+		if (!provided[slot]) {
+			prototype->defaults.emplace_back(slot, var.second.type);
+		}
+	}
+
+	return prototype;
+}
+
 void Interpreter::check_build_array(RuntimeValue* new_value, std::vector<size_t> dim) {
 	auto arr = new_value->get_arr();
 	auto arrsize = arr.size();
@@ -2124,12 +2773,21 @@ void Interpreter::clear_current_expression() {
 }
 
 void Interpreter::declare_function_parameter(std::shared_ptr<Scope> scope, const std::string& identifier, TypeDefinition variable, RuntimeValue* value) {
-	if (TypeUtils::is_function(value->type)) {
+	if (TypeUtils::is_function(value->type) && value->get_fun().definition) {
+		scope->declare_function(identifier, *value->get_fun().definition);
+	}
+	else if (auto func_scope = TypeUtils::is_function(value->type) ? value->get_fun().scope.lock() : nullptr;
+		func_scope && func_scope->generation == value->get_fun().generation) {
+		for (const auto& function : *func_scope->find_declared_functions(value->get_fun().second)) {
+			scope->declare_function(identifier, function);
+		}
+	}
+	else if (TypeUtils::is_function(value->type)) {
 		const auto& prg = current_program_stack.top();
 		const auto& name_space = value->get_fun().first;
 		auto funcs = get_inner_most_functions_scope(prg, name_space, value->get_fun().second)->find_declared_functions(value->get_fun().second);
-		for (auto& it = funcs.first; it != funcs.second; ++it) {
-			scope->declare_function(identifier, it->second);
+		for (const auto& function : *funcs) {
+			scope->declare_function(identifier, function);
 		}
 	}
 	else {
@@ -2145,10 +2803,6 @@ void Interpreter::declare_function_parameter(std::shared_ptr<Scope> scope, const
 	}
 }
 
-bool Interpreter::is_builtin_execution_block(std::vector<std::shared_ptr<ASTNode>> statements) {
-	return !function_call_name.empty() && statements.size() == 1 && std::dynamic_pointer_cast<ASTBuiltinCallNode>(statements[0]);
-}
-
 void Interpreter::declare_function_block_parameters(const std::string& name_space) {
 	auto& curr_scope = scopes[name_space].back();
 	auto rest_name = std::string();
@@ -2189,7 +2843,7 @@ void Interpreter::declare_function_block_parameters(const std::string& name_spac
 					if (current_function_defined_parameters.top().size() - 1 == i
 						&& TypeUtils::is_array(current_value->type)) {
 						for (size_t i = 0; i < vec.size(); ++i) {
-							vec.push_back(current_value->get_arr()[i]);
+							vec.push_back((*current_value->get_raw_arr())[i]);
 						}
 					}
 					else {
@@ -2199,7 +2853,7 @@ void Interpreter::declare_function_block_parameters(const std::string& name_spac
 			}
 			else if (const auto decls = dynamic_cast<UnpackedVariableDefinition*>(current_function_defined_parameters.top()[i])) {
 				for (auto& decl : decls->variables) {
-					auto sub_value = allocate_value(new RuntimeValue(current_value->get_str()[decl.identifier]));
+					auto sub_value = allocate_value(new RuntimeValue(current_value->find_sub(decl.identifier)));
 					declare_function_parameter(curr_scope, decl.identifier, decl, sub_value);
 				}
 			}
@@ -8,6 +8,9 @@
 #include <unordered_map>
 #include <functional>
 #include <memory>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
 
 #include "types.hpp"
 #include "visitor.hpp"
@@ -20,14 +23,44 @@ namespace core {
 
 	namespace runtime {
 
+		// native function, called with the arguments bound in the order of its parameters, it sets the result slot
+		typedef std::function<void(std::span<RuntimeValue* const> args, RuntimeValue*& result)> builtin_func_t;
+
+		// error raised by a flexa throw, it carries the thrown value, which stays rooted until
+		// a catch takes it or it's reported, the message is only built when it's read
+		class ThrownError : public std::runtime_error {
+		private:
+			mutable std::string message;
+
+		public:
+			RuntimeValue* value;
+
+			ThrownError(RuntimeValue* value);
+
+			const char* what() const noexcept override;
+		};
+
 		class Interpreter : public Visitor, public ScopeManager {
 		public:
 			bool exit_from_program = false;
-			std::map<std::string, std::function<void()>> builtin_functions;
+			// builtins are called by the index their declarations resolve when interpreted
+			std::vector<builtin_func_t> builtin_functions;
+			std::unordered_map<std::string, size_t> builtin_indexes;
 			RuntimeValue* current_expression_value;
 			GarbageCollector gc;
 
+			// native stack reserved for each call level when sizing the execution stack
+			static const size_t CALL_STACK_SIZE = 16 * 1024;
+			// native stack kept free for the work done between two calls
+			static const size_t STACK_SAFETY_MARGIN = 256 * 1024;
+
+			// calls deeper than this raise a catchable error, zero means unlimited
+			size_t max_call_depth = 0;
+			// size of the native stack the interpreter runs on, zero when unknown
+			size_t stack_size = 0;
+
 			RuntimeValue* allocate_value(RuntimeValue* value);
+			void register_builtin(const std::string& identifier, builtin_func_t function);
 
 		private:
 			dim_eval_func_t evaluate_access_vector_ptr = std::bind(&Interpreter::evaluate_access_vector, this, std::placeholders::_1);
@@ -49,6 +82,31 @@ namespace core {
 			bool has_string_access = false;
 			bool exception = false;
 
+			// call scheduled by a return in tail position, run by the caller frame once the returning block unwinds
+			bool tail_call = false;
+			FunctionDefinition tail_call_function;
+			std::vector<TypeDefinition*> tail_call_signature;
+			std::shared_ptr<std::vector<RuntimeValue*>> tail_call_arguments;
+			std::shared_ptr<ASTProgramNode> tail_call_program;
+
+			size_t call_depth = 0;
+			uintptr_t call_stack_base = 0;
+
+			// sizes of the call state, so an error unwinding a call can restore it
+			struct CallState {
+				size_t call_depth;
+				size_t functions;
+				size_t defined_parameters;
+				size_t calling_arguments;
+				size_t this_names;
+				size_t signatures;
+				size_t expression_identifier_vectors;
+				size_t expression_calls;
+				size_t programs;
+				size_t is_loop;
+				size_t is_switch;
+			};
+
 			std::vector<size_t> current_expression_array_dim;
 			int current_expression_array_dim_max = 0;
 			TypeDefinition current_expression_array_type;
@@ -61,6 +119,10 @@ namespace core {
 			void clear_current_expression();
 
 			void declare_function_parameter(std::shared_ptr<Scope> scope, const std::string& identifier, TypeDefinition variable, RuntimeValue* value);
+			void declare_value(std::shared_ptr<ASTDeclarationNode> astnode, RuntimeValue* new_value, bool assigned);
+			void bind_caught_error(std::shared_ptr<ASTNode> decl, const std::runtime_error& ex);
+			// copies struct fields and array items recursively, so the copy shares nothing with the value
+			RuntimeValue* deep_copy_value(RuntimeValue* value);
 
 			std::vector<size_t> evaluate_access_vector(const std::vector<std::shared_ptr<ASTExprNode>>& expr_access_vector);
 			std::vector<size_t> calculate_array_dim_size(const flx_array& arr);
@@ -68,17 +130,47 @@ namespace core {
 			void check_build_array(RuntimeValue* new_value, std::vector<size_t> dim);
 			flx_array build_array(const std::vector<size_t>& dim, RuntimeValue* init_value, intmax_t i);
 
+			void bind_foreach_variable(std::shared_ptr<RuntimeVariable> var, std::shared_ptr<ASTDeclarationNode> itdecl,
+				const std::vector<size_t>& dim, RuntimeValue* value, RuntimeValue*& owned);
+
+			void typed_binary_operation(std::shared_ptr<ASTBinaryExprNode> astnode, RuntimeValue* l_value);
+			void binary_operation(std::shared_ptr<ASTBinaryExprNode> astnode, RuntimeValue* l_value, RuntimeValue* r_value);
+
+			std::shared_ptr<StructConstructorPrototype> build_struct_prototype(std::shared_ptr<ASTStructConstructorNode> astnode, const StructureDefinition& type_struct);
+
 			RuntimeValue* set_value(std::shared_ptr<RuntimeVariable> var, const std::vector<Identifier>& identifier_vector, RuntimeValue* new_value);
 			RuntimeValue* access_value(RuntimeValue* value, const std::vector<Identifier>& identifier_vector, size_t i = 0);
 
+			FunctionDefinition& find_called_function(std::shared_ptr<ASTFunctionCallNode> astnode, RuntimeValue* returned_expression_value,
+				std::vector<RuntimeValue*>& function_arguments, std::vector<TypeDefinition*>& signature, std::string& identifier, bool& pop_program);
+			void run_function(FunctionDefinition& declfun, const std::string& identifier, const std::vector<TypeDefinition*>& signature,
+				std::shared_ptr<std::vector<RuntimeValue*>> function_arguments, const std::vector<Identifier>& expression_identifier_vector,
+				std::shared_ptr<ASTFunctionCallNode> expression_call, bool pop_program, const CallState& state);
+			void run_builtin(const FunctionDefinition& declfun, std::shared_ptr<std::vector<RuntimeValue*>> function_arguments,
+				const std::vector<Identifier>& expression_identifier_vector, bool pop_program, const CallState& state);
+			RuntimeValue* call_builtin(const FunctionDefinition& declfun, std::vector<RuntimeValue*>& arguments);
+			FunctionDefinition& find_function_value(const flx_function& fun, const std::vector<TypeDefinition*>& signature,
+				std::string& identifier, bool& pop_program);
+			std::shared_ptr<Scope> capture_environment(std::shared_ptr<ASTLambdaFunction> astnode);
+			void push_environment(const Atom& name_space, const std::shared_ptr<Scope>& environment);
+			void pop_environment(const Atom& name_space, const std::shared_ptr<Scope>& environment);
+			CallState save_call_state();
+			void restore_call_state(const CallState& state);
+			void check_call_depth();
+			void schedule_tail_call(std::shared_ptr<ASTFunctionCallNode> astnode);
+			void activate_return(const std::string& name_space);
+			bool has_access(const std::vector<Identifier>& identifier_vector);
+
 			std::shared_ptr<Scope> find_declared_function(const std::shared_ptr<ASTProgramNode>& current_program, const std::string& name_space,
 				const std::string& identifier, const std::vector<TypeDefinition*>& signature, bool& strict, bool& pop_program);
 			std::shared_ptr<Scope> find_declared_function_strict(const std::shared_ptr<ASTProgramNode>& current_program, const std::string& name_space,
 				const std::string& identifier, const std::vector<TypeDefinition*>& signature, bool& strict, bool& pop_program);
 
 			intmax_t hash(RuntimeValue* value);
+			void check_string_position(RuntimeValue* value, intmax_t pos);
+			// the condition is copied, evaluating a case expression replaces the current value
+			size_t find_string_case(std::shared_ptr<ASTSwitchNode> astnode, flx_string value);
 
-			bool is_builtin_execution_block(std::vector<std::shared_ptr<ASTNode>> statements);
 			void declare_function_block_parameters(const std::string& name_space);
 			void build_args(const std::vector<std::string>& args);
 
@@ -93,6 +185,14 @@ namespace core {
 
 			void start();
 
+			static size_t execution_stack_size(size_t max_call_depth);
+
+			// calls a function value from native code, binding the arguments straight into its frame,
+			// arguments must stay reachable by the collector while it runs. the result isn't rooted, it's
+			// only valid until the next call or collection, callers keeping it across them must root it
+			// with gc.add_root and release it with gc.remove_root
+			RuntimeValue* call(const flx_function& function, std::span<RuntimeValue* const> arguments);
+
 			void visit(std::shared_ptr<ASTProgramNode>) override;
 			void visit(std::shared_ptr<ASTUsingNode>) override;
 			void visit(std::shared_ptr<ASTIncludeNamespaceNode>) override;
@@ -144,7 +244,6 @@ namespace core {
 			void visit(std::shared_ptr<ASTIsArrayNode>) override;
 			void visit(std::shared_ptr<ASTIsAnyNode>) override;
 			void visit(std::shared_ptr<ASTValueNode>) override;
-			void visit(std::shared_ptr<ASTBuiltinCallNode>) override;
 
 			intmax_t hash(std::shared_ptr<ASTExprNode>) override;
 			intmax_t hash(std::shared_ptr<ASTValueNode>) override;
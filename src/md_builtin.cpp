@@ -48,92 +48,86 @@ void ModuleBuiltin::register_functions(SemanticAnalyser* visitor) {
 	visitor->scopes[Constants::DEFAULT_NAMESPACE].back()->declare_function(Constants::BUILTIN_NAMES.at(BuintinFuncs::SYSTEM), func_decls[Constants::BUILTIN_NAMES.at(BuintinFuncs::SYSTEM)]);
 	visitor->builtin_functions[Constants::BUILTIN_NAMES.at(BuintinFuncs::SYSTEM)] = nullptr;
 
+	visitor->scopes[Constants::DEFAULT_NAMESPACE].back()->declare_function(Constants::BUILTIN_NAMES.at(BuintinFuncs::HASH), func_decls[Constants::BUILTIN_NAMES.at(BuintinFuncs::HASH)]);
+	visitor->builtin_functions[Constants::BUILTIN_NAMES.at(BuintinFuncs::HASH)] = nullptr;
+
 }
 
 void ModuleBuiltin::register_functions(Interpreter* visitor) {
-	visitor->scopes[Constants::DEFAULT_NAMESPACE].back()->declare_function(Constants::BUILTIN_NAMES.at(BuintinFuncs::PRINT), func_decls[Constants::BUILTIN_NAMES.at(BuintinFuncs::PRINT)]);
-	visitor->builtin_functions[Constants::BUILTIN_NAMES.at(BuintinFuncs::PRINT)] = [this, visitor]() {
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+	auto print = [](std::span<RuntimeValue* const> args, RuntimeValue*&) {
+		const auto& values = args[0]->get_arr();
 
-		auto& scope = visitor->scopes[Constants::DEFAULT_NAMESPACE].back();
-		if (scope->already_declared_variable("args")) {
-			auto var = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("args"));
-			auto args = var->get_value()->get_arr();
-
-			for (size_t i = 0; i < args.size(); ++i) {
-				std::cout << RuntimeOperations::parse_value_to_string(args[i]);
-			}
+		for (size_t i = 0; i < values.size(); ++i) {
+			std::cout << RuntimeOperations::parse_value_to_string(values[i]);
 		}
 
 		};
 
-	visitor->scopes[Constants::DEFAULT_NAMESPACE].back()->declare_function(Constants::BUILTIN_NAMES.at(BuintinFuncs::PRINTLN), func_decls[Constants::BUILTIN_NAMES.at(BuintinFuncs::PRINTLN)]);
-	visitor->builtin_functions[Constants::BUILTIN_NAMES.at(BuintinFuncs::PRINTLN)] = [this, visitor]() {
-		visitor->builtin_functions[Constants::BUILTIN_NAMES.at(BuintinFuncs::PRINT)]();
+	visitor->register_builtin(Constants::BUILTIN_NAMES.at(BuintinFuncs::PRINT), print);
+	declare_builtin(visitor, Constants::BUILTIN_NAMES.at(BuintinFuncs::PRINT), Constants::BUILTIN_NAMES.at(BuintinFuncs::PRINT));
+
+	visitor->register_builtin(Constants::BUILTIN_NAMES.at(BuintinFuncs::PRINTLN), [print](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		print(args, result);
 		std::cout << std::endl;
-		};
+		});
+	declare_builtin(visitor, Constants::BUILTIN_NAMES.at(BuintinFuncs::PRINTLN), Constants::BUILTIN_NAMES.at(BuintinFuncs::PRINTLN));
 
-	visitor->scopes[Constants::DEFAULT_NAMESPACE].back()->declare_function(Constants::BUILTIN_NAMES.at(BuintinFuncs::READ), func_decls[Constants::BUILTIN_NAMES.at(BuintinFuncs::READ)]);
-	visitor->builtin_functions[Constants::BUILTIN_NAMES.at(BuintinFuncs::READ)] = [this, visitor]() {
-		visitor->builtin_functions[Constants::BUILTIN_NAMES.at(BuintinFuncs::PRINT)]();
+	visitor->register_builtin(Constants::BUILTIN_NAMES.at(BuintinFuncs::READ), [print, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		print(args, result);
 		std::string line;
 		std::getline(std::cin, line);
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_STRING));
-		visitor->current_expression_value->set(flx_string(std::move(line)));
-		};
+		result = visitor->allocate_value(new RuntimeValue(Type::T_STRING));
+		result->set(flx_string(std::move(line)));
+		});
+	declare_builtin(visitor, Constants::BUILTIN_NAMES.at(BuintinFuncs::READ), Constants::BUILTIN_NAMES.at(BuintinFuncs::READ));
 
-	visitor->scopes[Constants::DEFAULT_NAMESPACE].back()->declare_function(Constants::BUILTIN_NAMES.at(BuintinFuncs::READCH), func_decls[Constants::BUILTIN_NAMES.at(BuintinFuncs::READCH)]);
-	visitor->builtin_functions[Constants::BUILTIN_NAMES.at(BuintinFuncs::READCH)] = [this, visitor]() {
+	visitor->register_builtin(Constants::BUILTIN_NAMES.at(BuintinFuncs::READCH), [visitor](std::span<RuntimeValue* const>, RuntimeValue*& result) {
 		while (!_kbhit());
 		char ch = _getch();
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_CHAR));
-		visitor->current_expression_value->set(flx_char(ch));
-		};
+		result = visitor->allocate_value(new RuntimeValue(Type::T_CHAR));
+		result->set(flx_char(ch));
+		});
+	declare_builtin(visitor, Constants::BUILTIN_NAMES.at(BuintinFuncs::READCH), Constants::BUILTIN_NAMES.at(BuintinFuncs::READCH));
 
-	visitor->scopes[Constants::DEFAULT_NAMESPACE].back()->declare_function(Constants::BUILTIN_NAMES.at(BuintinFuncs::LEN), func_decls[Constants::BUILTIN_NAMES.at(BuintinFuncs::LEN) + "A"]);
-	visitor->scopes[Constants::DEFAULT_NAMESPACE].back()->declare_function(Constants::BUILTIN_NAMES.at(BuintinFuncs::LEN), func_decls[Constants::BUILTIN_NAMES.at(BuintinFuncs::LEN) + "S"]);
-	visitor->builtin_functions[Constants::BUILTIN_NAMES.at(BuintinFuncs::LEN)] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::DEFAULT_NAMESPACE].back();
-		auto var = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("it"));
-		auto itval = var->get_value();
+	visitor->register_builtin(Constants::BUILTIN_NAMES.at(BuintinFuncs::LEN), [visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto itval = args[0];
 
-		auto val = visitor->allocate_value(new RuntimeValue(Type::T_INT));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_INT));
 
 		if (TypeUtils::is_array(itval->type)) {
-			val->set(flx_int(itval->get_arr().size()));
+			result->set(flx_int(itval->get_arr().size()));
 		}
 		else {
-			val->set(flx_int(itval->get_s().size()));
+			result->set(flx_int(itval->get_s().size()));
 		}
 
-		visitor->current_expression_value = val;
-
-		};
-
-	visitor->scopes[Constants::DEFAULT_NAMESPACE].back()->declare_function(Constants::BUILTIN_NAMES.at(BuintinFuncs::SLEEP), func_decls[Constants::BUILTIN_NAMES.at(BuintinFuncs::SLEEP)]);
-	visitor->builtin_functions[Constants::BUILTIN_NAMES.at(BuintinFuncs::SLEEP)] = [this, visitor]() {
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
-
-		auto& scope = visitor->scopes[Constants::DEFAULT_NAMESPACE].back();
-		auto var = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("ms"));
-		auto ms = var->get_value()->get_i();
+		});
+	declare_builtin(visitor, Constants::BUILTIN_NAMES.at(BuintinFuncs::LEN), Constants::BUILTIN_NAMES.at(BuintinFuncs::LEN) + "A");
+	declare_builtin(visitor, Constants::BUILTIN_NAMES.at(BuintinFuncs::LEN), Constants::BUILTIN_NAMES.at(BuintinFuncs::LEN) + "S");
 
-		std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+	visitor->register_builtin(Constants::BUILTIN_NAMES.at(BuintinFuncs::SLEEP), [](std::span<RuntimeValue* const> args, RuntimeValue*&) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(args[0]->get_i()));
+		});
+	declare_builtin(visitor, Constants::BUILTIN_NAMES.at(BuintinFuncs::SLEEP), Constants::BUILTIN_NAMES.at(BuintinFuncs::SLEEP));
 
-		};
-
-	visitor->scopes[Constants::DEFAULT_NAMESPACE].back()->declare_function(Constants::BUILTIN_NAMES.at(BuintinFuncs::SYSTEM), func_decls[Constants::BUILTIN_NAMES.at(BuintinFuncs::SYSTEM)]);
-	visitor->builtin_functions[Constants::BUILTIN_NAMES.at(BuintinFuncs::SYSTEM)] = [this, visitor]() {
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+	visitor->register_builtin(Constants::BUILTIN_NAMES.at(BuintinFuncs::SYSTEM), [](std::span<RuntimeValue* const> args, RuntimeValue*&) {
+		system(args[0]->get_s().c_str());
+		});
+	declare_builtin(visitor, Constants::BUILTIN_NAMES.at(BuintinFuncs::SYSTEM), Constants::BUILTIN_NAMES.at(BuintinFuncs::SYSTEM));
 
-		auto& scope = visitor->scopes[Constants::DEFAULT_NAMESPACE].back();
-		auto var = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("cmd"));
-		auto cmd = var->get_value()->get_s();
+	// values equal by == have the same hash, arrays and structs are hashed by content
+	visitor->register_builtin(Constants::BUILTIN_NAMES.at(BuintinFuncs::HASH), [visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		result = visitor->allocate_value(new RuntimeValue(flx_int(RuntimeOperations::hash_value(args[0]))));
+		});
+	declare_builtin(visitor, Constants::BUILTIN_NAMES.at(BuintinFuncs::HASH), Constants::BUILTIN_NAMES.at(BuintinFuncs::HASH));
 
-		system(cmd.c_str());
-
-		};
+}
 
+void ModuleBuiltin::declare_builtin(Interpreter* visitor, const std::string& identifier, const std::string& decl_name) {
+	auto definition = func_decls.at(decl_name);
+	definition.is_builtin = true;
+	definition.builtin_index = visitor->builtin_indexes.at(identifier);
+	visitor->scopes[Constants::DEFAULT_NAMESPACE].back()->declare_function(identifier, definition);
 }
 
 void ModuleBuiltin::build_decls() {
@@ -143,55 +137,44 @@ void ModuleBuiltin::build_decls() {
 	parameters = std::vector<TypeDefinition*>();
 	variable = new VariableDefinition("args", Type::T_ANY, std::make_shared<ASTNullNode>(0, 0), true);
 	parameters.push_back(variable);
-	func_decls.emplace(Constants::BUILTIN_NAMES.at(BuintinFuncs::PRINT), FunctionDefinition(Constants::BUILTIN_NAMES.at(BuintinFuncs::PRINT), Type::T_VOID, parameters,
-		std::make_shared<ASTBlockNode>(std::vector<std::shared_ptr<ASTNode>>{
-		std::make_shared<ASTBuiltinCallNode>(Constants::BUILTIN_NAMES.at(BuintinFuncs::PRINT), 0, 0)}, 0, 0)));
+	func_decls.emplace(Constants::BUILTIN_NAMES.at(BuintinFuncs::PRINT), FunctionDefinition(Constants::BUILTIN_NAMES.at(BuintinFuncs::PRINT), Type::T_VOID, parameters, nullptr));
 
 	parameters = std::vector<TypeDefinition*>();
 	variable = new VariableDefinition("args", Type::T_ANY, std::make_shared<ASTNullNode>(0, 0), true);
 	parameters.push_back(variable);
-	func_decls.emplace(Constants::BUILTIN_NAMES.at(BuintinFuncs::PRINTLN), FunctionDefinition(Constants::BUILTIN_NAMES.at(BuintinFuncs::PRINTLN), Type::T_VOID, parameters,
-		std::make_shared<ASTBlockNode>(std::vector<std::shared_ptr<ASTNode>>{
-		std::make_shared<ASTBuiltinCallNode>(Constants::BUILTIN_NAMES.at(BuintinFuncs::PRINTLN), 0, 0)}, 0, 0)));
+	func_decls.emplace(Constants::BUILTIN_NAMES.at(BuintinFuncs::PRINTLN), FunctionDefinition(Constants::BUILTIN_NAMES.at(BuintinFuncs::PRINTLN), Type::T_VOID, parameters, nullptr));
 
 	parameters = std::vector<TypeDefinition*>();
 	variable = new VariableDefinition("args", Type::T_ANY, std::make_shared<ASTNullNode>(0, 0), true);
 	parameters.push_back(variable);
-	func_decls.emplace(Constants::BUILTIN_NAMES.at(BuintinFuncs::READ), FunctionDefinition(Constants::BUILTIN_NAMES.at(BuintinFuncs::READ), Type::T_STRING, parameters,
-		std::make_shared<ASTBlockNode>(std::vector<std::shared_ptr<ASTNode>>{
-		std::make_shared<ASTBuiltinCallNode>(Constants::BUILTIN_NAMES.at(BuintinFuncs::READ), 0, 0)}, 0, 0)));
+	func_decls.emplace(Constants::BUILTIN_NAMES.at(BuintinFuncs::READ), FunctionDefinition(Constants::BUILTIN_NAMES.at(BuintinFuncs::READ), Type::T_STRING, parameters, nullptr));
 
 	parameters = std::vector<TypeDefinition*>();
-	func_decls.emplace(Constants::BUILTIN_NAMES.at(BuintinFuncs::READCH), FunctionDefinition(Constants::BUILTIN_NAMES.at(BuintinFuncs::READCH), Type::T_CHAR, parameters,
-		std::make_shared<ASTBlockNode>(std::vector<std::shared_ptr<ASTNode>>{
-		std::make_shared<ASTBuiltinCallNode>(Constants::BUILTIN_NAMES.at(BuintinFuncs::READCH), 0, 0)}, 0, 0)));
+	func_decls.emplace(Constants::BUILTIN_NAMES.at(BuintinFuncs::READCH), FunctionDefinition(Constants::BUILTIN_NAMES.at(BuintinFuncs::READCH), Type::T_CHAR, parameters, nullptr));
 
 	parameters = std::vector<TypeDefinition*>();
 	variable = new VariableDefinition("it", Type::T_ANY, std::vector<size_t>());
 	parameters.push_back(variable);
-	func_decls.emplace(Constants::BUILTIN_NAMES.at(BuintinFuncs::LEN) + "A", FunctionDefinition(Constants::BUILTIN_NAMES.at(BuintinFuncs::LEN) + "A", Type::T_INT, parameters,
-		std::make_shared<ASTBlockNode>(std::vector<std::shared_ptr<ASTNode>>{
-		std::make_shared<ASTBuiltinCallNode>(Constants::BUILTIN_NAMES.at(BuintinFuncs::LEN), 0, 0)}, 0, 0)));
+	func_decls.emplace(Constants::BUILTIN_NAMES.at(BuintinFuncs::LEN) + "A", FunctionDefinition(Constants::BUILTIN_NAMES.at(BuintinFuncs::LEN) + "A", Type::T_INT, parameters, nullptr));
 
 	parameters = std::vector<TypeDefinition*>();
 	variable = new VariableDefinition("it", Type::T_STRING);
 	parameters.push_back(variable);
-	func_decls.emplace(Constants::BUILTIN_NAMES.at(BuintinFuncs::LEN) + "S", FunctionDefinition(Constants::BUILTIN_NAMES.at(BuintinFuncs::LEN) + "S", Type::T_INT, parameters,
-		std::make_shared<ASTBlockNode>(std::vector<std::shared_ptr<ASTNode>>{
-		std::make_shared<ASTBuiltinCallNode>(Constants::BUILTIN_NAMES.at(BuintinFuncs::LEN), 0, 0)}, 0, 0)));
+	func_decls.emplace(Constants::BUILTIN_NAMES.at(BuintinFuncs::LEN) + "S", FunctionDefinition(Constants::BUILTIN_NAMES.at(BuintinFuncs::LEN) + "S", Type::T_INT, parameters, nullptr));
 
 	parameters = std::vector<TypeDefinition*>();
 	variable = new VariableDefinition("ms", Type::T_INT);
 	parameters.push_back(variable);
-	func_decls.emplace(Constants::BUILTIN_NAMES.at(BuintinFuncs::SLEEP), FunctionDefinition(Constants::BUILTIN_NAMES.at(BuintinFuncs::SLEEP), Type::T_VOID, parameters,
-		std::make_shared<ASTBlockNode>(std::vector<std::shared_ptr<ASTNode>>{
-		std::make_shared<ASTBuiltinCallNode>(Constants::BUILTIN_NAMES.at(BuintinFuncs::SLEEP), 0, 0)}, 0, 0)));
+	func_decls.emplace(Constants::BUILTIN_NAMES.at(BuintinFuncs::SLEEP), FunctionDefinition(Constants::BUILTIN_NAMES.at(BuintinFuncs::SLEEP), Type::T_VOID, parameters, nullptr));
 
 	parameters = std::vector<TypeDefinition*>();
 	variable = new VariableDefinition("cmd", Type::T_STRING);
 	parameters.push_back(variable);
-	func_decls.emplace(Constants::BUILTIN_NAMES.at(BuintinFuncs::SYSTEM), FunctionDefinition(Constants::BUILTIN_NAMES.at(BuintinFuncs::SYSTEM), Type::T_VOID, parameters,
-		std::make_shared<ASTBlockNode>(std::vector<std::shared_ptr<ASTNode>>{
-		std::make_shared<ASTBuiltinCallNode>(Constants::BUILTIN_NAMES.at(BuintinFuncs::SYSTEM), 0, 0)}, 0, 0)));
+	func_decls.emplace(Constants::BUILTIN_NAMES.at(BuintinFuncs::SYSTEM), FunctionDefinition(Constants::BUILTIN_NAMES.at(BuintinFuncs::SYSTEM), Type::T_VOID, parameters, nullptr));
+
+	parameters = std::vector<TypeDefinition*>();
+	variable = new VariableDefinition("it", Type::T_ANY);
+	parameters.push_back(variable);
+	func_decls.emplace(Constants::BUILTIN_NAMES.at(BuintinFuncs::HASH), FunctionDefinition(Constants::BUILTIN_NAMES.at(BuintinFuncs::HASH), Type::T_INT, parameters, nullptr));
 
 }
@@ -25,6 +25,8 @@ namespace core {
 
 		private:
 			void build_decls();
+			// declares a builtin with the index of its native function
+			void declare_builtin(runtime::Interpreter* visitor, const std::string& identifier, const std::string& decl_name);
 		};
 
 	}
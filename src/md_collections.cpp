@@ -0,0 +1,977 @@
+#include "md_collections.hpp"
+
+#include <algorithm>
+
+#include "interpreter.hpp"
+#include "semantic_analysis.hpp"
+#include "constants.hpp"
+
+using namespace core;
+using namespace core::modules;
+using namespace core::runtime;
+using namespace core::analysis;
+
+NativeDeque::NativeDeque()
+	: buffer(std::vector<RuntimeValue*>(8)), head(0), count(0) {}
+
+void NativeDeque::grow() {
+	std::vector<RuntimeValue*> grown(buffer.size() * 2);
+	for (size_t i = 0; i < count; ++i) {
+		grown[i] = buffer[(head + i) & (buffer.size() - 1)];
+	}
+	buffer = std::move(grown);
+	head = 0;
+}
+
+void NativeDeque::push_front(RuntimeValue* value) {
+	if (count == buffer.size()) {
+		grow();
+	}
+	head = (head + buffer.size() - 1) & (buffer.size() - 1);
+	buffer[head] = value;
+	++count;
+}
+
+void NativeDeque::push_back(RuntimeValue* value) {
+	if (count == buffer.size()) {
+		grow();
+	}
+	buffer[(head + count) & (buffer.size() - 1)] = value;
+	++count;
+}
+
+RuntimeValue* NativeDeque::pop_front() {
+	auto value = buffer[head];
+	buffer[head] = nullptr;
+	head = (head + 1) & (buffer.size() - 1);
+	--count;
+	return value;
+}
+
+RuntimeValue* NativeDeque::pop_back() {
+	auto& slot = buffer[(head + count - 1) & (buffer.size() - 1)];
+	auto value = slot;
+	slot = nullptr;
+	--count;
+	return value;
+}
+
+RuntimeValue* NativeDeque::front() const {
+	return buffer[head];
+}
+
+RuntimeValue* NativeDeque::back() const {
+	return buffer[(head + count - 1) & (buffer.size() - 1)];
+}
+
+RuntimeValue* NativeDeque::at(size_t index) const {
+	return buffer[(head + index) & (buffer.size() - 1)];
+}
+
+size_t NativeDeque::size() const {
+	return count;
+}
+
+void NativeDeque::clear() {
+	std::fill(buffer.begin(), buffer.end(), nullptr);
+	head = 0;
+	count = 0;
+}
+
+std::vector<GCObject*> NativeDeque::get_references() {
+	std::vector<GCObject*> references;
+	references.reserve(count);
+	for (size_t i = 0; i < count; ++i) {
+		references.push_back(at(i));
+	}
+	return references;
+}
+
+void NativeList::push_back(RuntimeValue* value) {
+	values.push_back(value);
+}
+
+void NativeList::insert(size_t index, RuntimeValue* value) {
+	values.insert(values.begin() + index, value);
+}
+
+RuntimeValue* NativeList::pop_back() {
+	auto value = values.back();
+	values.pop_back();
+	return value;
+}
+
+RuntimeValue* NativeList::remove_at(size_t index) {
+	auto value = values[index];
+	values.erase(values.begin() + index);
+	return value;
+}
+
+RuntimeValue* NativeList::back() const {
+	return values.back();
+}
+
+RuntimeValue* NativeList::at(size_t index) const {
+	return values[index];
+}
+
+void NativeList::set(size_t index, RuntimeValue* value) {
+	values[index] = value;
+}
+
+void NativeList::sort(const std::function<bool(RuntimeValue*, RuntimeValue*)>& less) {
+	// a copy is sorted, so a failing comparison leaves the list as it was
+	auto sorted = values;
+	std::stable_sort(sorted.begin(), sorted.end(), less);
+	values = std::move(sorted);
+}
+
+size_t NativeList::size() const {
+	return values.size();
+}
+
+void NativeList::clear() {
+	values.clear();
+}
+
+std::vector<GCObject*> NativeList::get_references() {
+	return std::vector<GCObject*>(values.begin(), values.end());
+}
+
+namespace {
+
+	size_t lower_index(const std::vector<RuntimeValue*>& keys, RuntimeValue* key) {
+		return std::lower_bound(keys.begin(), keys.end(), key, [](RuntimeValue* entry, RuntimeValue* key) {
+			return RuntimeOperations::compare_value(entry, key) < 0;
+			}) - keys.begin();
+	}
+
+	size_t upper_index(const std::vector<RuntimeValue*>& keys, RuntimeValue* key) {
+		return std::upper_bound(keys.begin(), keys.end(), key, [](RuntimeValue* key, RuntimeValue* entry) {
+			return RuntimeOperations::compare_value(key, entry) < 0;
+			}) - keys.begin();
+	}
+
+	void collect_references(NativeOrderedMap::Node* node, std::vector<GCObject*>& references) {
+		references.insert(references.end(), node->keys.begin(), node->keys.end());
+		references.insert(references.end(), node->values.begin(), node->values.end());
+		for (auto child : node->children) {
+			collect_references(child, references);
+		}
+	}
+
+}
+
+NativeOrderedMap::Node::Node(bool leaf)
+	: leaf(leaf) {}
+
+NativeOrderedMap::Node::~Node() {
+	for (auto child : children) {
+		delete child;
+	}
+}
+
+bool NativeOrderedMap::Cursor::valid() const {
+	return node && index < node->keys.size();
+}
+
+void NativeOrderedMap::Cursor::advance() {
+	++index;
+	while (node && index >= node->keys.size()) {
+		node = node->next;
+		index = 0;
+	}
+}
+
+RuntimeValue* NativeOrderedMap::Cursor::key() const {
+	return node->keys[index];
+}
+
+RuntimeValue* NativeOrderedMap::Cursor::value() const {
+	return node->values[index];
+}
+
+NativeOrderedMap::NativeOrderedMap()
+	: root(new Node(true)), count(0) {}
+
+NativeOrderedMap::~NativeOrderedMap() {
+	delete root;
+}
+
+NativeOrderedMap::Node* NativeOrderedMap::insert(Node* node, RuntimeValue* key, RuntimeValue* value, RuntimeValue*& separator, bool& inserted) {
+	if (node->leaf) {
+		size_t pos = lower_index(node->keys, key);
+		if (pos < node->keys.size() && RuntimeOperations::compare_value(node->keys[pos], key) == 0) {
+			node->values[pos] = value;
+			return nullptr;
+		}
+
+		node->keys.insert(node->keys.begin() + pos, key);
+		node->values.insert(node->values.begin() + pos, value);
+		inserted = true;
+
+		if (node->keys.size() <= MAX_KEYS) {
+			return nullptr;
+		}
+
+		// split leaf, the first key of the right half is copied up
+		auto right = new Node(true);
+		size_t mid = node->keys.size() / 2;
+		right->keys.assign(node->keys.begin() + mid, node->keys.end());
+		right->values.assign(node->values.begin() + mid, node->values.end());
+		node->keys.resize(mid);
+		node->values.resize(mid);
+
+		right->next = node->next;
+		if (right->next) {
+			right->next->prev = right;
+		}
+		right->prev = node;
+		node->next = right;
+
+		separator = right->keys.front();
+		return right;
+	}
+
+	size_t index = upper_index(node->keys, key);
+	RuntimeValue* child_separator = nullptr;
+	auto split = insert(node->children[index], key, value, child_separator, inserted);
+	if (!split) {
+		return nullptr;
+	}
+
+	node->keys.insert(node->keys.begin() + index, child_separator);
+	node->children.insert(node->children.begin() + index + 1, split);
+
+	if (node->keys.size() <= MAX_KEYS) {
+		return nullptr;
+	}
+
+	// split inner node, the middle key is moved up
+	auto right = new Node(false);
+	size_t mid = node->keys.size() / 2;
+	separator = node->keys[mid];
+	right->keys.assign(node->keys.begin() + mid + 1, node->keys.end());
+	right->children.assign(node->children.begin() + mid + 1, node->children.end());
+	node->keys.resize(mid);
+	node->children.resize(mid + 1);
+
+	return right;
+}
+
+bool NativeOrderedMap::insert(RuntimeValue* key, RuntimeValue* value) {
+	RuntimeValue* separator = nullptr;
+	bool inserted = false;
+
+	auto split = insert(root, key, value, separator, inserted);
+	if (split) {
+		auto new_root = new Node(false);
+		new_root->keys.push_back(separator);
+		new_root->children.push_back(root);
+		new_root->children.push_back(split);
+		root = new_root;
+	}
+
+	if (inserted) {
+		++count;
+	}
+
+	return inserted;
+}
+
+bool NativeOrderedMap::erase(Node* node, RuntimeValue* key) {
+	if (node->leaf) {
+		size_t pos = lower_index(node->keys, key);
+		if (pos == node->keys.size() || RuntimeOperations::compare_value(node->keys[pos], key) != 0) {
+			return false;
+		}
+		node->keys.erase(node->keys.begin() + pos);
+		node->values.erase(node->values.begin() + pos);
+		return true;
+	}
+
+	size_t index = upper_index(node->keys, key);
+	if (!erase(node->children[index], key)) {
+		return false;
+	}
+
+	if (node->children[index]->keys.size() < MIN_KEYS) {
+		rebalance(node, index);
+	}
+
+	return true;
+}
+
+void NativeOrderedMap::rebalance(Node* parent, size_t index) {
+	auto child = parent->children[index];
+	auto left = index > 0 ? parent->children[index - 1] : nullptr;
+	auto right = index + 1 < parent->children.size() ? parent->children[index + 1] : nullptr;
+
+	// borrow from left sibling
+	if (left && left->keys.size() > MIN_KEYS) {
+		if (child->leaf) {
+			child->keys.insert(child->keys.begin(), left->keys.back());
+			child->values.insert(child->values.begin(), left->values.back());
+			left->keys.pop_back();
+			left->values.pop_back();
+			parent->keys[index - 1] = child->keys.front();
+		}
+		else {
+			child->keys.insert(child->keys.begin(), parent->keys[index - 1]);
+			child->children.insert(child->children.begin(), left->children.back());
+			parent->keys[index - 1] = left->keys.back();
+			left->keys.pop_back();
+			left->children.pop_back();
+		}
+		return;
+	}
+
+	// borrow from right sibling
+	if (right && right->keys.size() > MIN_KEYS) {
+		if (child->leaf) {
+			child->keys.push_back(right->keys.front());
+			child->values.push_back(right->values.front());
+			right->keys.erase(right->keys.begin());
+			right->values.erase(right->values.begin());
+			parent->keys[index] = right->keys.front();
+		}
+		else {
+			child->keys.push_back(parent->keys[index]);
+			child->children.push_back(right->children.front());
+			parent->keys[index] = right->keys.front();
+			right->keys.erase(right->keys.begin());
+			right->children.erase(right->children.begin());
+		}
+		return;
+	}
+
+	// merge with a sibling, always merging the right node into the left one
+	if (!left && !right) {
+		return;
+	}
+	size_t merge_index = left ? index - 1 : index;
+	auto lnode = parent->children[merge_index];
+	auto rnode = parent->children[merge_index + 1];
+
+	if (lnode->leaf) {
+		lnode->keys.insert(lnode->keys.end(), rnode->keys.begin(), rnode->keys.end());
+		lnode->values.insert(lnode->values.end(), rnode->values.begin(), rnode->values.end());
+		lnode->next = rnode->next;
+		if (lnode->next) {
+			lnode->next->prev = lnode;
+		}
+	}
+	else {
+		lnode->keys.push_back(parent->keys[merge_index]);
+		lnode->keys.insert(lnode->keys.end(), rnode->keys.begin(), rnode->keys.end());
+		lnode->children.insert(lnode->children.end(), rnode->children.begin(), rnode->children.end());
+		rnode->children.clear();
+	}
+
+	delete rnode;
+	parent->keys.erase(parent->keys.begin() + merge_index);
+	parent->children.erase(parent->children.begin() + merge_index + 1);
+}
+
+bool NativeOrderedMap::erase(RuntimeValue* key) {
+	if (!erase(root, key)) {
+		return false;
+	}
+
+	// shrink tree height when root is left with a single child
+	if (!root->leaf && root->keys.empty()) {
+		auto old_root = root;
+		root = root->children.front();
+		old_root->children.clear();
+		delete old_root;
+	}
+
+	--count;
+	return true;
+}
+
+RuntimeValue* NativeOrderedMap::find(RuntimeValue* key) const {
+	auto cursor = lower_bound(key);
+	if (cursor.valid() && RuntimeOperations::compare_value(cursor.key(), key) == 0) {
+		return cursor.value();
+	}
+	return nullptr;
+}
+
+NativeOrderedMap::Cursor NativeOrderedMap::bound(RuntimeValue* key, bool upper) const {
+	Node* node = root;
+	while (!node->leaf) {
+		node = node->children[upper_index(node->keys, key)];
+	}
+
+	Cursor cursor{ node, upper ? upper_index(node->keys, key) : lower_index(node->keys, key) };
+	while (cursor.node && cursor.index >= cursor.node->keys.size()) {
+		cursor.node = cursor.node->next;
+		cursor.index = 0;
+	}
+
+	return cursor;
+}
+
+NativeOrderedMap::Cursor NativeOrderedMap::first() const {
+	Node* node = root;
+	while (!node->leaf) {
+		node = node->children.front();
+	}
+	return Cursor{ node->keys.empty() ? nullptr : node, 0 };
+}
+
+NativeOrderedMap::Cursor NativeOrderedMap::last() const {
+	Node* node = root;
+	while (!node->leaf) {
+		node = node->children.back();
+	}
+	if (node->keys.empty()) {
+		return Cursor{ nullptr, 0 };
+	}
+	return Cursor{ node, node->keys.size() - 1 };
+}
+
+NativeOrderedMap::Cursor NativeOrderedMap::lower_bound(RuntimeValue* key) const {
+	return bound(key, false);
+}
+
+NativeOrderedMap::Cursor NativeOrderedMap::upper_bound(RuntimeValue* key) const {
+	return bound(key, true);
+}
+
+size_t NativeOrderedMap::size() const {
+	return count;
+}
+
+void NativeOrderedMap::clear() {
+	delete root;
+	root = new Node(true);
+	count = 0;
+}
+
+std::vector<GCObject*> NativeOrderedMap::get_references() {
+	std::vector<GCObject*> references;
+	collect_references(root, references);
+	return references;
+}
+
+namespace {
+
+	size_t get_index(RuntimeValue* value, size_t size, bool inclusive = false) {
+		auto index = value->get_i();
+		if (index < 0 || size_t(index) > size || (size_t(index) == size && !inclusive)) {
+			throw std::runtime_error("invalid collection access position " + std::to_string(index) + " in a collection with size " + std::to_string(size));
+		}
+		return size_t(index);
+	}
+
+	// references are stored as is, other values are copied as in assignment
+	RuntimeValue* store_value(Interpreter* visitor, RuntimeValue* value) {
+		return value->use_ref ? value : visitor->allocate_value(new RuntimeValue(value));
+	}
+
+	void check_not_empty(size_t size, const std::string& name) {
+		if (size == 0) {
+			throw std::runtime_error(name + " is empty");
+		}
+	}
+
+	// keys are copied, so the caller can not change the ordering from outside
+	RuntimeValue* store_key(Interpreter* visitor, RuntimeValue* key) {
+		switch (key->type) {
+		case Type::T_BOOL:
+		case Type::T_INT:
+		case Type::T_FLOAT:
+		case Type::T_CHAR:
+		case Type::T_STRING:
+			return visitor->allocate_value(new RuntimeValue(key));
+		default:
+			throw std::runtime_error("invalid ordered map key type '" + TypeUtils::type_str(key->type) + "'");
+		}
+	}
+
+	RuntimeValue* build_entry(Interpreter* visitor, const NativeOrderedMap::Cursor& cursor) {
+		if (!cursor.valid()) {
+			return visitor->allocate_value(new RuntimeValue(Type::T_VOID));
+		}
+
+		flx_struct str = flx_struct();
+		str["key"] = visitor->allocate_value(new RuntimeValue(cursor.key()));
+		str["value"] = cursor.value();
+
+		return visitor->allocate_value(new RuntimeValue(str, "Pair", Constants::STD_NAMESPACE));
+	}
+
+	// builds a entry array from cursor until end cursor or the end of the map
+	RuntimeValue* build_entries(Interpreter* visitor, NativeOrderedMap::Cursor cursor, const NativeOrderedMap::Cursor& end) {
+		std::vector<RuntimeValue*> entries;
+		while (cursor.valid() && !(cursor.node == end.node && cursor.index == end.index)) {
+			entries.push_back(build_entry(visitor, cursor));
+			cursor.advance();
+		}
+
+		flx_array arr = flx_array(entries.size());
+		for (size_t i = 0; i < entries.size(); ++i) {
+			arr[i] = entries[i];
+		}
+
+		return visitor->allocate_value(new RuntimeValue(arr, Type::T_STRUCT, std::vector<size_t>{entries.size()}, "Pair", Constants::STD_NAMESPACE));
+	}
+
+}
+
+ModuleCollections::ModuleCollections() {}
+
+ModuleCollections::~ModuleCollections() = default;
+
+void ModuleCollections::register_functions(SemanticAnalyser* visitor) {
+	visitor->builtin_functions["create_deque"] = nullptr;
+	visitor->builtin_functions["deque_push_front"] = nullptr;
+	visitor->builtin_functions["deque_push_back"] = nullptr;
+	visitor->builtin_functions["deque_pop_front"] = nullptr;
+	visitor->builtin_functions["deque_pop_back"] = nullptr;
+	visitor->builtin_functions["deque_front"] = nullptr;
+	visitor->builtin_functions["deque_back"] = nullptr;
+	visitor->builtin_functions["deque_get"] = nullptr;
+	visitor->builtin_functions["deque_size"] = nullptr;
+	visitor->builtin_functions["deque_is_empty"] = nullptr;
+	visitor->builtin_functions["deque_clear"] = nullptr;
+
+	visitor->builtin_functions["create_queue"] = nullptr;
+	visitor->builtin_functions["queue_enqueue"] = nullptr;
+	visitor->builtin_functions["queue_dequeue"] = nullptr;
+	visitor->builtin_functions["queue_peek"] = nullptr;
+	visitor->builtin_functions["queue_size"] = nullptr;
+	visitor->builtin_functions["queue_is_empty"] = nullptr;
+	visitor->builtin_functions["queue_clear"] = nullptr;
+
+	visitor->builtin_functions["create_stack"] = nullptr;
+	visitor->builtin_functions["stack_push"] = nullptr;
+	visitor->builtin_functions["stack_pop"] = nullptr;
+	visitor->builtin_functions["stack_peek"] = nullptr;
+	visitor->builtin_functions["stack_size"] = nullptr;
+	visitor->builtin_functions["stack_is_empty"] = nullptr;
+	visitor->builtin_functions["stack_clear"] = nullptr;
+
+	visitor->builtin_functions["create_list"] = nullptr;
+	visitor->builtin_functions["list_add"] = nullptr;
+	visitor->builtin_functions["list_insert"] = nullptr;
+	visitor->builtin_functions["list_get"] = nullptr;
+	visitor->builtin_functions["list_set"] = nullptr;
+	visitor->builtin_functions["list_remove_at"] = nullptr;
+	visitor->builtin_functions["list_size"] = nullptr;
+	visitor->builtin_functions["list_is_empty"] = nullptr;
+	visitor->builtin_functions["list_clear"] = nullptr;
+	visitor->builtin_functions["list_to_array"] = nullptr;
+	visitor->builtin_functions["list_sort"] = nullptr;
+
+	visitor->builtin_functions["create_ordered_map"] = nullptr;
+	visitor->builtin_functions["omap_insert"] = nullptr;
+	visitor->builtin_functions["omap_get"] = nullptr;
+	visitor->builtin_functions["omap_contains"] = nullptr;
+	visitor->builtin_functions["omap_erase"] = nullptr;
+	visitor->builtin_functions["omap_first"] = nullptr;
+	visitor->builtin_functions["omap_last"] = nullptr;
+	visitor->builtin_functions["omap_lower_bound"] = nullptr;
+	visitor->builtin_functions["omap_upper_bound"] = nullptr;
+	visitor->builtin_functions["omap_range"] = nullptr;
+	visitor->builtin_functions["omap_entries"] = nullptr;
+	visitor->builtin_functions["omap_size"] = nullptr;
+	visitor->builtin_functions["omap_is_empty"] = nullptr;
+	visitor->builtin_functions["omap_clear"] = nullptr;
+}
+
+void ModuleCollections::register_functions(Interpreter* visitor) {
+
+	// deque
+
+	visitor->register_builtin("create_deque", [this, visitor](std::span<RuntimeValue* const>, RuntimeValue*& result) {
+		result = build_native_object(visitor, new NativeDeque(), "Deque");
+
+		});
+
+	visitor->register_builtin("deque_push_front", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto deque = get_native_object<NativeDeque>(visitor, args[0]);
+		deque->push_front(store_value(visitor, args[1]));
+
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+
+		});
+
+	visitor->register_builtin("deque_push_back", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto deque = get_native_object<NativeDeque>(visitor, args[0]);
+		deque->push_back(store_value(visitor, args[1]));
+
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+
+		});
+
+	visitor->register_builtin("deque_pop_front", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto deque = get_native_object<NativeDeque>(visitor, args[0]);
+		check_not_empty(deque->size(), "deque");
+
+		result = deque->pop_front();
+
+		});
+
+	visitor->register_builtin("deque_pop_back", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto deque = get_native_object<NativeDeque>(visitor, args[0]);
+		check_not_empty(deque->size(), "deque");
+
+		result = deque->pop_back();
+
+		});
+
+	visitor->register_builtin("deque_front", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto deque = get_native_object<NativeDeque>(visitor, args[0]);
+		check_not_empty(deque->size(), "deque");
+
+		result = deque->front();
+
+		});
+
+	visitor->register_builtin("deque_back", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto deque = get_native_object<NativeDeque>(visitor, args[0]);
+		check_not_empty(deque->size(), "deque");
+
+		result = deque->back();
+
+		});
+
+	visitor->register_builtin("deque_get", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto deque = get_native_object<NativeDeque>(visitor, args[0]);
+
+		result = deque->at(get_index(args[1], deque->size()));
+
+		});
+
+	visitor->register_builtin("deque_size", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto deque = get_native_object<NativeDeque>(visitor, args[0]);
+
+		result = visitor->allocate_value(new RuntimeValue(flx_int(deque->size())));
+
+		});
+
+	visitor->register_builtin("deque_is_empty", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto deque = get_native_object<NativeDeque>(visitor, args[0]);
+
+		result = visitor->allocate_value(new RuntimeValue(flx_bool(deque->size() == 0)));
+
+		});
+
+	visitor->register_builtin("deque_clear", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		get_native_object<NativeDeque>(visitor, args[0])->clear();
+
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+
+		});
+
+	// queue
+
+	visitor->register_builtin("create_queue", [this, visitor](std::span<RuntimeValue* const>, RuntimeValue*& result) {
+		result = build_native_object(visitor, new NativeDeque(), "Queue");
+
+		});
+
+	visitor->register_builtin("queue_enqueue", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto queue = get_native_object<NativeDeque>(visitor, args[0]);
+		queue->push_back(store_value(visitor, args[1]));
+
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+
+		});
+
+	visitor->register_builtin("queue_dequeue", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto queue = get_native_object<NativeDeque>(visitor, args[0]);
+		check_not_empty(queue->size(), "queue");
+
+		result = queue->pop_front();
+
+		});
+
+	visitor->register_builtin("queue_peek", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto queue = get_native_object<NativeDeque>(visitor, args[0]);
+		check_not_empty(queue->size(), "queue");
+
+		result = queue->front();
+
+		});
+
+	visitor->register_builtin("queue_size", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto queue = get_native_object<NativeDeque>(visitor, args[0]);
+
+		result = visitor->allocate_value(new RuntimeValue(flx_int(queue->size())));
+
+		});
+
+	visitor->register_builtin("queue_is_empty", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto queue = get_native_object<NativeDeque>(visitor, args[0]);
+
+		result = visitor->allocate_value(new RuntimeValue(flx_bool(queue->size() == 0)));
+
+		});
+
+	visitor->register_builtin("queue_clear", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		get_native_object<NativeDeque>(visitor, args[0])->clear();
+
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+
+		});
+
+	// stack
+
+	visitor->register_builtin("create_stack", [this, visitor](std::span<RuntimeValue* const>, RuntimeValue*& result) {
+		result = build_native_object(visitor, new NativeList(), "Stack");
+
+		});
+
+	visitor->register_builtin("stack_push", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto stack = get_native_object<NativeList>(visitor, args[0]);
+		stack->push_back(store_value(visitor, args[1]));
+
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+
+		});
+
+	visitor->register_builtin("stack_pop", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto stack = get_native_object<NativeList>(visitor, args[0]);
+		check_not_empty(stack->size(), "stack");
+
+		result = stack->pop_back();
+
+		});
+
+	visitor->register_builtin("stack_peek", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto stack = get_native_object<NativeList>(visitor, args[0]);
+		check_not_empty(stack->size(), "stack");
+
+		result = stack->back();
+
+		});
+
+	visitor->register_builtin("stack_size", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto stack = get_native_object<NativeList>(visitor, args[0]);
+
+		result = visitor->allocate_value(new RuntimeValue(flx_int(stack->size())));
+
+		});
+
+	visitor->register_builtin("stack_is_empty", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto stack = get_native_object<NativeList>(visitor, args[0]);
+
+		result = visitor->allocate_value(new RuntimeValue(flx_bool(stack->size() == 0)));
+
+		});
+
+	visitor->register_builtin("stack_clear", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		get_native_object<NativeList>(visitor, args[0])->clear();
+
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+
+		});
+
+	// list
+
+	visitor->register_builtin("create_list", [this, visitor](std::span<RuntimeValue* const>, RuntimeValue*& result) {
+		result = build_native_object(visitor, new NativeList(), "List");
+
+		});
+
+	visitor->register_builtin("list_add", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto list = get_native_object<NativeList>(visitor, args[0]);
+		list->push_back(store_value(visitor, args[1]));
+
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+
+		});
+
+	visitor->register_builtin("list_insert", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto list = get_native_object<NativeList>(visitor, args[0]);
+		auto index = get_index(args[1], list->size(), true);
+		list->insert(index, store_value(visitor, args[2]));
+
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+
+		});
+
+	visitor->register_builtin("list_get", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto list = get_native_object<NativeList>(visitor, args[0]);
+
+		result = list->at(get_index(args[1], list->size()));
+
+		});
+
+	visitor->register_builtin("list_set", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto list = get_native_object<NativeList>(visitor, args[0]);
+		auto index = get_index(args[1], list->size());
+		list->set(index, store_value(visitor, args[2]));
+
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+
+		});
+
+	visitor->register_builtin("list_remove_at", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto list = get_native_object<NativeList>(visitor, args[0]);
+
+		result = list->remove_at(get_index(args[1], list->size()));
+
+		});
+
+	visitor->register_builtin("list_size", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto list = get_native_object<NativeList>(visitor, args[0]);
+
+		result = visitor->allocate_value(new RuntimeValue(flx_int(list->size())));
+
+		});
+
+	visitor->register_builtin("list_is_empty", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto list = get_native_object<NativeList>(visitor, args[0]);
+
+		result = visitor->allocate_value(new RuntimeValue(flx_bool(list->size() == 0)));
+
+		});
+
+	visitor->register_builtin("list_clear", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		get_native_object<NativeList>(visitor, args[0])->clear();
+
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+
+		});
+
+	visitor->register_builtin("list_to_array", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto list = get_native_object<NativeList>(visitor, args[0]);
+
+		flx_array arr = flx_array(list->size());
+		for (size_t i = 0; i < list->size(); ++i) {
+			arr[i] = list->at(i);
+		}
+
+		result = visitor->allocate_value(new RuntimeValue(arr, Type::T_ANY, std::vector<size_t>{list->size()}, "", ""));
+
+		});
+
+	visitor->register_builtin("list_sort", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto list = get_native_object<NativeList>(visitor, args[0]);
+		auto less = args[1]->get_fun();
+
+		list->sort([visitor, &less](RuntimeValue* lval, RuntimeValue* rval) {
+			RuntimeValue* arguments[] = { lval, rval };
+			auto result = visitor->call(less, arguments);
+			if (!TypeUtils::is_bool(result->type)) {
+				throw std::runtime_error("list sort comparison must return a bool");
+			}
+			return result->get_b();
+			});
+
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+
+		});
+
+
+	// ordered map
+
+	visitor->register_builtin("create_ordered_map", [this, visitor](std::span<RuntimeValue* const>, RuntimeValue*& result) {
+		result = build_native_object(visitor, new NativeOrderedMap(), "OrderedMap");
+
+		});
+
+	visitor->register_builtin("omap_insert", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto map = get_native_object<NativeOrderedMap>(visitor, args[0]);
+		auto key = store_key(visitor, args[1]);
+		auto inserted = map->insert(key, store_value(visitor, args[2]));
+
+		result = visitor->allocate_value(new RuntimeValue(flx_bool(inserted)));
+
+		});
+
+	visitor->register_builtin("omap_get", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto map = get_native_object<NativeOrderedMap>(visitor, args[0]);
+		auto value = map->find(args[1]);
+
+		result = value ? value : visitor->allocate_value(new RuntimeValue(Type::T_VOID));
+
+		});
+
+	visitor->register_builtin("omap_contains", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto map = get_native_object<NativeOrderedMap>(visitor, args[0]);
+
+		result = visitor->allocate_value(new RuntimeValue(flx_bool(map->find(args[1]) != nullptr)));
+
+		});
+
+	visitor->register_builtin("omap_erase", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto map = get_native_object<NativeOrderedMap>(visitor, args[0]);
+
+		result = visitor->allocate_value(new RuntimeValue(flx_bool(map->erase(args[1]))));
+
+		});
+
+	visitor->register_builtin("omap_first", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto map = get_native_object<NativeOrderedMap>(visitor, args[0]);
+
+		result = build_entry(visitor, map->first());
+
+		});
+
+	visitor->register_builtin("omap_last", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto map = get_native_object<NativeOrderedMap>(visitor, args[0]);
+
+		result = build_entry(visitor, map->last());
+
+		});
+
+	visitor->register_builtin("omap_lower_bound", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto map = get_native_object<NativeOrderedMap>(visitor, args[0]);
+
+		result = build_entry(visitor, map->lower_bound(args[1]));
+
+		});
+
+	visitor->register_builtin("omap_upper_bound", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto map = get_native_object<NativeOrderedMap>(visitor, args[0]);
+
+		result = build_entry(visitor, map->upper_bound(args[1]));
+
+		});
+
+	visitor->register_builtin("omap_range", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto map = get_native_object<NativeOrderedMap>(visitor, args[0]);
+		auto from = args[1];
+		auto to = args[2];
+
+		result = RuntimeOperations::compare_value(from, to) < 0
+			? build_entries(visitor, map->lower_bound(from), map->lower_bound(to))
+			: build_entries(visitor, NativeOrderedMap::Cursor{ nullptr, 0 }, NativeOrderedMap::Cursor{ nullptr, 0 });
+
+		});
+
+	visitor->register_builtin("omap_entries", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto map = get_native_object<NativeOrderedMap>(visitor, args[0]);
+
+		result = build_entries(visitor, map->first(), NativeOrderedMap::Cursor{ nullptr, 0 });
+
+		});
+
+	visitor->register_builtin("omap_size", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto map = get_native_object<NativeOrderedMap>(visitor, args[0]);
+
+		result = visitor->allocate_value(new RuntimeValue(flx_int(map->size())));
+
+		});
+
+	visitor->register_builtin("omap_is_empty", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto map = get_native_object<NativeOrderedMap>(visitor, args[0]);
+
+		result = visitor->allocate_value(new RuntimeValue(flx_bool(map->size() == 0)));
+
+		});
+
+	visitor->register_builtin("omap_clear", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		get_native_object<NativeOrderedMap>(visitor, args[0])->clear();
+
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+
+		});
+
+}
@@ -0,0 +1,130 @@
+#ifndef MD_COLLECTIONS_HPP
+#define MD_COLLECTIONS_HPP
+
+#include <vector>
+#include <functional>
+
+#include "module.hpp"
+#include "types.hpp"
+
+namespace core {
+
+	namespace modules {
+
+		// growable circular buffer, used by deque and queue
+		class NativeDeque : public runtime::GCObject {
+		private:
+			std::vector<RuntimeValue*> buffer;
+			size_t head;
+			size_t count;
+
+			void grow();
+
+		public:
+			NativeDeque();
+
+			void push_front(RuntimeValue* value);
+			void push_back(RuntimeValue* value);
+			RuntimeValue* pop_front();
+			RuntimeValue* pop_back();
+			RuntimeValue* front() const;
+			RuntimeValue* back() const;
+			RuntimeValue* at(size_t index) const;
+
+			size_t size() const;
+			void clear();
+
+			virtual std::vector<runtime::GCObject*> get_references() override;
+		};
+
+		// contiguous list, used by list and stack
+		class NativeList : public runtime::GCObject {
+		private:
+			std::vector<RuntimeValue*> values;
+
+		public:
+			void push_back(RuntimeValue* value);
+			void insert(size_t index, RuntimeValue* value);
+			RuntimeValue* pop_back();
+			RuntimeValue* remove_at(size_t index);
+			RuntimeValue* back() const;
+			RuntimeValue* at(size_t index) const;
+			void set(size_t index, RuntimeValue* value);
+			void sort(const std::function<bool(RuntimeValue*, RuntimeValue*)>& less);
+
+			size_t size() const;
+			void clear();
+
+			virtual std::vector<runtime::GCObject*> get_references() override;
+		};
+
+		// ordered map implemented as a b+ tree, leaves are linked for range scans
+		class NativeOrderedMap : public runtime::GCObject {
+		public:
+			static const size_t MAX_KEYS = 32;
+			static const size_t MIN_KEYS = MAX_KEYS / 2;
+
+			struct Node {
+				bool leaf;
+				std::vector<RuntimeValue*> keys;
+				std::vector<RuntimeValue*> values;
+				std::vector<Node*> children;
+				Node* prev = nullptr;
+				Node* next = nullptr;
+
+				Node(bool leaf);
+				~Node();
+			};
+
+			struct Cursor {
+				Node* node;
+				size_t index;
+
+				bool valid() const;
+				void advance();
+				RuntimeValue* key() const;
+				RuntimeValue* value() const;
+			};
+
+		private:
+			Node* root;
+			size_t count;
+
+			Node* insert(Node* node, RuntimeValue* key, RuntimeValue* value, RuntimeValue*& separator, bool& inserted);
+			bool erase(Node* node, RuntimeValue* key);
+			void rebalance(Node* parent, size_t index);
+			Cursor bound(RuntimeValue* key, bool upper) const;
+
+		public:
+			NativeOrderedMap();
+			~NativeOrderedMap();
+
+			bool insert(RuntimeValue* key, RuntimeValue* value);
+			bool erase(RuntimeValue* key);
+			RuntimeValue* find(RuntimeValue* key) const;
+
+			Cursor first() const;
+			Cursor last() const;
+			Cursor lower_bound(RuntimeValue* key) const;
+			Cursor upper_bound(RuntimeValue* key) const;
+
+			size_t size() const;
+			void clear();
+
+			virtual std::vector<runtime::GCObject*> get_references() override;
+		};
+
+		class ModuleCollections : public Module {
+		public:
+			ModuleCollections();
+			~ModuleCollections();
+
+			void register_functions(analysis::SemanticAnalyser* visitor) override;
+			void register_functions(runtime::Interpreter* visitor) override;
+		};
+
+	}
+
+}
+
+#endif // !MD_COLLECTIONS_HPP
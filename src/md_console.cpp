@@ -36,39 +36,37 @@ void ModuleConsole::register_functions(SemanticAnalyser* visitor) {
 
 void ModuleConsole::register_functions(Interpreter* visitor) {
 
-	visitor->builtin_functions["show_console"] = [this, visitor]() {
+	visitor->register_builtin("show_console", [this, visitor]([[maybe_unused]] std::span<RuntimeValue* const> args, [[maybe_unused]] RuntimeValue*& result) {
 #if defined(_WIN32) || defined(WIN32)
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("show"))->get_value();
+		auto val = args[0];
 
 		::ShowWindow(::GetConsoleWindow(), val->get_b());
 
 #endif // linux
 		
-		};
+		});
 
-	visitor->builtin_functions["is_console_visible"] = [this, visitor]() {
+	visitor->register_builtin("is_console_visible", [this, visitor](std::span<RuntimeValue* const>, RuntimeValue*& result) {
 #ifdef linux
 		
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(flx_bool(true)));
+		result = visitor->allocate_value(new RuntimeValue(flx_bool(true)));
 
 #elif defined(_WIN32) || defined(WIN32)
 		
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(flx_bool(::IsWindowVisible(::GetConsoleWindow()))));
+		result = visitor->allocate_value(new RuntimeValue(flx_bool(::IsWindowVisible(::GetConsoleWindow()))));
 
 #endif // linux
 				
-		};
+		});
 
-	visitor->builtin_functions["set_console_color"] = [this, visitor]() {
+	visitor->register_builtin("set_console_color", [this, visitor](std::span<RuntimeValue* const> args, [[maybe_unused]] RuntimeValue*& result) {
 
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
 		auto vals = std::vector {
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("background_color"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("foreground_color"))->get_value()
+			args[0],
+			args[1]
 		};
 
 #ifdef linux
@@ -77,22 +75,21 @@ void ModuleConsole::register_functions(Interpreter* visitor) {
 
 #elif defined(_WIN32) || defined(WIN32)
 				
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
 		HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
 		SetConsoleTextAttribute(hConsole, vals[0]->get_i() * 0x10 | vals[1]->get_i());
 		
 #endif // linux
 
-		};
+		});
 
-	visitor->builtin_functions["set_console_cursor_position"] = [this, visitor]() {
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+	visitor->register_builtin("set_console_cursor_position", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
 		auto vals = std::vector{
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("x"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("y"))->get_value()
+			args[0],
+			args[1]
 		};
 
 #ifdef linux
@@ -107,9 +104,9 @@ void ModuleConsole::register_functions(Interpreter* visitor) {
 		
 #endif // linux
 
-		};
+		});
 
-	visitor->builtin_functions["set_console_font"] = [this, visitor]() {
+	visitor->register_builtin("set_console_font", [this, visitor]([[maybe_unused]] std::span<RuntimeValue* const> args, [[maybe_unused]] RuntimeValue*& result) {
 
 #ifdef linux
 		
@@ -117,16 +114,15 @@ void ModuleConsole::register_functions(Interpreter* visitor) {
 		
 #elif defined(_WIN32) || defined(WIN32)
 		
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
 		auto vals = std::vector{
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("font_name"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("font_width"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("font_height"))->get_value()
+			args[0],
+			args[1],
+			args[2]
 		};
 
-		auto nfontname = vals[0]->get_s();
+		const auto& nfontname = vals[0]->get_s();
 		auto pfontname = std::wstring(nfontname.begin(), nfontname.end());
 		int pwidth = vals[1]->get_i();
 		int pheight = vals[2]->get_i();
@@ -145,6 +141,6 @@ void ModuleConsole::register_functions(Interpreter* visitor) {
 				
 #endif // linux
 
-		};
+		});
 
 }
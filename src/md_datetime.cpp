@@ -41,13 +41,11 @@ void ModuleDateTime::register_functions(SemanticAnalyser* visitor) {
 
 void ModuleDateTime::register_functions(Interpreter* visitor) {
 
-	visitor->builtin_functions["create_date_time"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-
+	visitor->register_builtin("create_date_time", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
 		tm* tm = new struct tm();
 		time_t t;
 
-		if (scope->total_declared_variables() == 0) {
+		if (args.size() == 0) {
 			t = time(nullptr);
 
 #ifdef linux
@@ -61,8 +59,8 @@ void ModuleDateTime::register_functions(Interpreter* visitor) {
 #endif // linux
 
 		}
-		else if (scope->total_declared_variables() == 1) {
-			auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("timestamp"))->get_value();
+		else if (args.size() == 1) {
+			auto val = args[0];
 
 			t = val->get_i();
 
@@ -79,12 +77,12 @@ void ModuleDateTime::register_functions(Interpreter* visitor) {
 		}
 		else {
 			auto vals = std::vector{
-				std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("year"))->get_value(),
-				std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("month"))->get_value(),
-				std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("day"))->get_value(),
-				std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("hour"))->get_value(),
-				std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("min"))->get_value(),
-				std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("sec"))->get_value()
+				args[0],
+				args[1],
+				args[2],
+				args[3],
+				args[4],
+				args[5]
 			};
 
 			tm->tm_year = vals[0]->get_i() - 1900;
@@ -96,19 +94,18 @@ void ModuleDateTime::register_functions(Interpreter* visitor) {
 			t = mktime(tm);
 		}
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(tm_to_date_time(visitor, t, tm), "DateTime", Constants::STD_NAMESPACE));
+		result = visitor->allocate_value(new RuntimeValue(tm_to_date_time(visitor, t, tm), "DateTime", Constants::STD_NAMESPACE));
 
-		};
+		});
 
-	visitor->builtin_functions["diff_date_time"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
+	visitor->register_builtin("diff_date_time", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
 		auto vals = std::vector{
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("left_date_time"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("right_date_time"))->get_value()
+			args[0],
+			args[1]
 		};
 
-		time_t lt = vals[0]->get_str()["timestamp"]->get_i();
-		time_t rt = vals[1]->get_str()["timestamp"]->get_i();
+		time_t lt = vals[0]->find_sub("timestamp")->get_i();
+		time_t rt = vals[1]->find_sub("timestamp")->get_i();
 		time_t t = difftime(lt, rt);
 		tm* tm = new struct tm();
 
@@ -122,19 +119,18 @@ void ModuleDateTime::register_functions(Interpreter* visitor) {
 
 #endif // linux		
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(tm_to_date_time(visitor, t, tm), "DateTime", Constants::STD_NAMESPACE));
+		result = visitor->allocate_value(new RuntimeValue(tm_to_date_time(visitor, t, tm), "DateTime", Constants::STD_NAMESPACE));
 
-		};
+		});
 
-	visitor->builtin_functions["format_date_time"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
+	visitor->register_builtin("format_date_time", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
 		auto vals = std::vector{
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("date_time"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("format"))->get_value()
+			args[0],
+			args[1]
 		};
 
-		time_t t = vals[0]->get_str()["timestamp"]->get_i();
-		std::string fmt = vals[1]->get_s();
+		time_t t = vals[0]->find_sub("timestamp")->get_i();
+		const std::string& fmt = vals[1]->get_s();
 		tm* tm = new struct tm();
 
 #ifdef linux
@@ -150,19 +146,18 @@ void ModuleDateTime::register_functions(Interpreter* visitor) {
 		char buffer[80];
 		strftime(buffer, 80, fmt.c_str(), tm);
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(std::string{ buffer }));
+		result = visitor->allocate_value(new RuntimeValue(std::string{ buffer }));
 
-		};
+		});
 
-	visitor->builtin_functions["format_local_date_time"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
+	visitor->register_builtin("format_local_date_time", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
 		auto vals = std::vector{
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("date_time"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("format"))->get_value()
+			args[0],
+			args[1]
 		};
 
-		time_t t = vals[0]->get_str()["timestamp"]->get_i();
-		std::string fmt = vals[1]->get_s();
+		time_t t = vals[0]->find_sub("timestamp")->get_i();
+		const std::string& fmt = vals[1]->get_s();
 		tm* tm = new struct tm();
 		
 #ifdef linux
@@ -178,15 +173,14 @@ void ModuleDateTime::register_functions(Interpreter* visitor) {
 		char buffer[80];
 		strftime(buffer, 80, fmt.c_str(), tm);
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(std::string{ buffer }));
+		result = visitor->allocate_value(new RuntimeValue(std::string{ buffer }));
 
-		};
+		});
 
-	visitor->builtin_functions["ascii_date_time"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("date_time"))->get_value();
+	visitor->register_builtin("ascii_date_time", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
-		time_t t = val->get_str()["timestamp"]->get_i();
+		time_t t = val->find_sub("timestamp")->get_i();
 		tm* tm = new struct tm();
 
 		char buffer[26];
@@ -209,15 +203,14 @@ void ModuleDateTime::register_functions(Interpreter* visitor) {
 
 #endif // linux
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(std::string{ buffer }));
+		result = visitor->allocate_value(new RuntimeValue(std::string{ buffer }));
 
-		};
+		});
 
-	visitor->builtin_functions["ascii_local_date_time"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("date_time"))->get_value();
+	visitor->register_builtin("ascii_local_date_time", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
-		time_t t = val->get_str()["timestamp"]->get_i();
+		time_t t = val->find_sub("timestamp")->get_i();
 		tm* tm = new struct tm();
 
 		char buffer[26];
@@ -240,13 +233,13 @@ void ModuleDateTime::register_functions(Interpreter* visitor) {
 
 #endif // linux
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(std::string{ buffer }));
+		result = visitor->allocate_value(new RuntimeValue(std::string{ buffer }));
 
-		};
+		});
 
-	visitor->builtin_functions["clock"] = [this, visitor]() {
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(flx_int(clock())));
+	visitor->register_builtin("clock", [this, visitor](std::span<RuntimeValue* const>, RuntimeValue*& result) {
+		result = visitor->allocate_value(new RuntimeValue(flx_int(clock())));
 
-		};
+		});
 
 }
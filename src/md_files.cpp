@@ -36,11 +36,10 @@ void ModuleFiles::register_functions(SemanticAnalyser* visitor) {
 
 void ModuleFiles::register_functions(Interpreter* visitor) {
 
-	visitor->builtin_functions["open"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
+	visitor->register_builtin("open", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
 		auto vals = std::vector{
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("path"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("mode"))->get_value()
+			args[0],
+			args[1]
 		};
 
 		// initialize file struct values
@@ -58,22 +57,21 @@ void ModuleFiles::register_functions(Interpreter* visitor) {
 			fs = new std::fstream(vals[0]->get_s(), mode);
 			str[INSTANCE_ID_NAME] = visitor->allocate_value(new RuntimeValue(flx_int(fs)));
 			cpfile->set(str, "File", Constants::STD_NAMESPACE);
-			visitor->current_expression_value = cpfile;
+			result = cpfile;
 		}
 		catch (std::runtime_error ex) {
 			throw std::runtime_error(ex.what());
 		}
 
-		};
+		});
 
-	visitor->builtin_functions["read"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("file"))->get_value();
+	visitor->register_builtin("read", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
 		if (!TypeUtils::is_void(val->type)) {
 			auto rval = visitor->allocate_value(new RuntimeValue(Type::T_STRING));
 
-			std::fstream* fs = ((std::fstream*)val->get_str()[INSTANCE_ID_NAME]->get_i());
+			std::fstream* fs = ((std::fstream*)val->find_sub(INSTANCE_ID_NAME)->get_i());
 
 			fs->seekg(0);
 
@@ -84,38 +82,36 @@ void ModuleFiles::register_functions(Interpreter* visitor) {
 			}
 			rval->set(ss.str());
 
-			visitor->current_expression_value = rval;
+			result = rval;
 		}
 
-		};
+		});
 
-	visitor->builtin_functions["read_line"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("file"))->get_value();
+	visitor->register_builtin("read_line", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
 		if (!TypeUtils::is_void(val->type)) {
 			auto rval = visitor->allocate_value(new RuntimeValue(Type::T_STRING));
 
-			std::fstream* fs = ((std::fstream*)val->get_str()[INSTANCE_ID_NAME]->get_i());
+			std::fstream* fs = ((std::fstream*)val->find_sub(INSTANCE_ID_NAME)->get_i());
 
 			std::string line;
 			std::getline(*fs, line);
 			rval->set(line);
 
-			visitor->current_expression_value = rval;
+			result = rval;
 		}
 
-		};
+		});
 
-	visitor->builtin_functions["read_all_bytes"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("file"))->get_value();
+	visitor->register_builtin("read_all_bytes", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
 		if (!TypeUtils::is_void(val->type)) {
 			auto rval = visitor->allocate_value(new RuntimeValue(Type::T_ARRAY));
 			rval->set_arr_type(Type::T_CHAR);
 
-			std::fstream* fs = ((std::fstream*)val->get_str()[INSTANCE_ID_NAME]->get_i());
+			std::fstream* fs = ((std::fstream*)val->find_sub(INSTANCE_ID_NAME)->get_i());
 
 			fs->seekg(0);
 
@@ -141,38 +137,36 @@ void ModuleFiles::register_functions(Interpreter* visitor) {
 
 			delete[] buffer;
 
-			visitor->current_expression_value = rval;
+			result = rval;
 		}
 
-		};
+		});
 
-	visitor->builtin_functions["write"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
+	visitor->register_builtin("write", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
 		auto vals = std::vector{
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("file"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("data"))->get_value()
+			args[0],
+			args[1]
 		};
 
 		RuntimeValue* cpfile = vals[0];
 		if (!TypeUtils::is_void(cpfile->type)) {
-			std::fstream* fs = ((std::fstream*)cpfile->get_str()[INSTANCE_ID_NAME]->get_i());
+			std::fstream* fs = ((std::fstream*)cpfile->find_sub(INSTANCE_ID_NAME)->get_i());
 			*fs << vals[1]->get_s();
 		}
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		};
+		});
 
-	visitor->builtin_functions["write_bytes"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
+	visitor->register_builtin("write_bytes", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
 		auto vals = std::vector{
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("file"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("bytes"))->get_value()
+			args[0],
+			args[1]
 		};
 
 		RuntimeValue* cpfile = vals[0];
 		if (!TypeUtils::is_void(cpfile->type)) {
-			std::fstream* fs = ((std::fstream*)cpfile->get_str()[INSTANCE_ID_NAME]->get_i());
+			std::fstream* fs = ((std::fstream*)cpfile->find_sub(INSTANCE_ID_NAME)->get_i());
 
 			auto arr = vals[1]->get_arr();
 
@@ -187,61 +181,56 @@ void ModuleFiles::register_functions(Interpreter* visitor) {
 			fs->write(buffer, sizeof(buffer));
 		}
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		};
+		});
 
-	visitor->builtin_functions["is_open"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("file"))->get_value();
+	visitor->register_builtin("is_open", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
 		if (!TypeUtils::is_void(val->type)) {
 			auto rval = visitor->allocate_value(new RuntimeValue(Type::T_BOOL));
-			rval->set(flx_bool(((std::fstream*)val->get_str()[INSTANCE_ID_NAME]->get_i())->is_open()));
-			visitor->current_expression_value = rval;
+			rval->set(flx_bool(((std::fstream*)val->find_sub(INSTANCE_ID_NAME)->get_i())->is_open()));
+			result = rval;
 		}
 
-		};
+		});
 
-	visitor->builtin_functions["close"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("file"))->get_value();
+	visitor->register_builtin("close", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
 		if (!TypeUtils::is_void(val->type)) {
-			if (((std::fstream*)val->get_str()[INSTANCE_ID_NAME]->get_i())) {
-				((std::fstream*)val->get_str()[INSTANCE_ID_NAME]->get_i())->close();
-				((std::fstream*)val->get_str()[INSTANCE_ID_NAME]->get_i())->~basic_fstream();
+			if (((std::fstream*)val->find_sub(INSTANCE_ID_NAME)->get_i())) {
+				((std::fstream*)val->find_sub(INSTANCE_ID_NAME)->get_i())->close();
+				((std::fstream*)val->find_sub(INSTANCE_ID_NAME)->get_i())->~basic_fstream();
 				val->set_null();
 			}
 		}
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		};
+		});
 
-	visitor->builtin_functions["is_file"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("path"))->get_value();
+	visitor->register_builtin("is_file", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
 		std::filesystem::path path = val->get_s();
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(std::filesystem::is_regular_file(path)));
+		result = visitor->allocate_value(new RuntimeValue(std::filesystem::is_regular_file(path)));
 
-		};
+		});
 
-	visitor->builtin_functions["is_dir"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("path"))->get_value();
+	visitor->register_builtin("is_dir", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
 		std::filesystem::path path = val->get_s();
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(std::filesystem::is_directory(path)));
+		result = visitor->allocate_value(new RuntimeValue(std::filesystem::is_directory(path)));
 
-		};
+		});
 
-	visitor->builtin_functions["create_dir"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("path"))->get_value();
+	visitor->register_builtin("create_dir", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
 		std::filesystem::path path = val->get_s();
 
@@ -249,13 +238,12 @@ void ModuleFiles::register_functions(Interpreter* visitor) {
 			throw std::runtime_error("cannot create directory");
 		}
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		};
+		});
 
-	visitor->builtin_functions["list_dir"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("path"))->get_value();
+	visitor->register_builtin("list_dir", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
 		std::filesystem::path path = val->get_s();
 
@@ -272,30 +260,28 @@ void ModuleFiles::register_functions(Interpreter* visitor) {
 			values[i] = visitor->allocate_value(new RuntimeValue(file));
 		}
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(values));
+		result = visitor->allocate_value(new RuntimeValue(values));
 
-		};
+		});
 
-	visitor->builtin_functions["path_exists"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("path"))->get_value();
+	visitor->register_builtin("path_exists", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
 		std::filesystem::path path = val->get_s();
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(std::filesystem::exists(path)));
+		result = visitor->allocate_value(new RuntimeValue(std::filesystem::exists(path)));
 
-		};
+		});
 
-	visitor->builtin_functions["delete_path"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("path"))->get_value();
+	visitor->register_builtin("delete_path", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
 		std::filesystem::path path = val->get_s();
 
 		std::filesystem::remove_all(path);
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		};
+		});
 
 }
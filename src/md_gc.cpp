@@ -4,10 +4,145 @@
 #include "semantic_analysis.hpp"
 #include "constants.hpp"
 
+using namespace core;
 using namespace core::modules;
 using namespace core::runtime;
 using namespace core::analysis;
 
+NativeWeakRef::NativeWeakRef(RuntimeValue* target)
+	: target(target) {}
+
+RuntimeValue* NativeWeakRef::get() const {
+	return target;
+}
+
+std::vector<GCObject*> NativeWeakRef::get_references() {
+	return std::vector<GCObject*>();
+}
+
+std::vector<GCObject*> NativeWeakRef::get_conditional_references() {
+	return std::vector<GCObject*>();
+}
+
+void NativeWeakRef::clear_dead_references() {
+	if (target && !target->marked) {
+		target = nullptr;
+	}
+}
+
+bool NativeWeakTable::KeyLess::operator()(RuntimeValue* lkey, RuntimeValue* rkey) const {
+	if (identity) {
+		return std::less<RuntimeValue*>()(lkey, rkey);
+	}
+	return RuntimeOperations::compare_value(lkey, rkey) < 0;
+}
+
+NativeWeakTable::NativeWeakTable(bool weak_keys, bool weak_values)
+	: weak_keys(weak_keys), weak_values(weak_values), entries(KeyLess{ weak_keys }) {}
+
+bool NativeWeakTable::has_weak_keys() const {
+	return weak_keys;
+}
+
+bool NativeWeakTable::has_weak_values() const {
+	return weak_values;
+}
+
+void NativeWeakTable::set(RuntimeValue* key, RuntimeValue* value) {
+	auto it = entries.find(key);
+	if (it != entries.end()) {
+		it->second = value;
+	}
+	else {
+		entries.emplace(key, value);
+	}
+}
+
+RuntimeValue* NativeWeakTable::get(RuntimeValue* key) const {
+	auto it = entries.find(key);
+	return it != entries.end() ? it->second : nullptr;
+}
+
+bool NativeWeakTable::remove(RuntimeValue* key) {
+	return entries.erase(key) > 0;
+}
+
+size_t NativeWeakTable::size() const {
+	return entries.size();
+}
+
+void NativeWeakTable::clear() {
+	entries.clear();
+}
+
+std::vector<GCObject*> NativeWeakTable::get_references() {
+	std::vector<GCObject*> references;
+	if (weak_keys) {
+		return references;
+	}
+	for (const auto& [key, value] : entries) {
+		references.push_back(key);
+		if (!weak_values) {
+			references.push_back(value);
+		}
+	}
+	return references;
+}
+
+std::vector<GCObject*> NativeWeakTable::get_conditional_references() {
+	std::vector<GCObject*> references;
+	if (!weak_keys || weak_values) {
+		return references;
+	}
+	// ephemeron: value is kept while its key is alive
+	for (const auto& [key, value] : entries) {
+		if (key->marked) {
+			references.push_back(value);
+		}
+	}
+	return references;
+}
+
+void NativeWeakTable::clear_dead_references() {
+	for (auto it = entries.begin(); it != entries.end(); ) {
+		if ((weak_keys && !it->first->marked) || (weak_values && !it->second->marked)) {
+			it = entries.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+}
+
+namespace {
+
+	// weak targets must keep their identity, so only references are accepted
+	RuntimeValue* check_weak_target(RuntimeValue* value) {
+		if (!value->use_ref && !TypeUtils::is_struct(value->type)) {
+			throw std::runtime_error("weak reference target must be a struct or a reference, found '"
+				+ TypeUtils::type_str(value->type) + "'");
+		}
+		return value;
+	}
+
+	RuntimeValue* store_table_key(Interpreter* visitor, NativeWeakTable* table, RuntimeValue* key) {
+		if (table->has_weak_keys()) {
+			return check_weak_target(key);
+		}
+		switch (key->type) {
+		case Type::T_BOOL:
+		case Type::T_INT:
+		case Type::T_FLOAT:
+		case Type::T_CHAR:
+		case Type::T_STRING:
+			return visitor->allocate_value(new RuntimeValue(key));
+		default:
+			throw std::runtime_error("invalid weak table key type '" + TypeUtils::type_str(key->type) + "'");
+		}
+	}
+
+}
+
 ModuleGC::ModuleGC() {}
 
 ModuleGC::~ModuleGC() = default;
@@ -18,46 +153,140 @@ void ModuleGC::register_functions(SemanticAnalyser* visitor) {
 	visitor->builtin_functions["gc_collect"] = nullptr;
 	visitor->builtin_functions["gc_get_max_heap"] = nullptr;
 	visitor->builtin_functions["gc_set_max_heap"] = nullptr;
+
+	visitor->builtin_functions["create_weak_ref"] = nullptr;
+	visitor->builtin_functions["weak_ref_get"] = nullptr;
+	visitor->builtin_functions["weak_ref_is_alive"] = nullptr;
+
+	visitor->builtin_functions["create_weak_table"] = nullptr;
+	visitor->builtin_functions["weak_table_set"] = nullptr;
+	visitor->builtin_functions["weak_table_get"] = nullptr;
+	visitor->builtin_functions["weak_table_contains"] = nullptr;
+	visitor->builtin_functions["weak_table_remove"] = nullptr;
+	visitor->builtin_functions["weak_table_size"] = nullptr;
+	visitor->builtin_functions["weak_table_clear"] = nullptr;
 }
 
 void ModuleGC::register_functions(Interpreter* visitor) {
 
-	visitor->builtin_functions["gc_is_enabled"] = [this, visitor]() {
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(flx_bool(visitor->gc.enable)));
+	visitor->register_builtin("gc_is_enabled", [this, visitor](std::span<RuntimeValue* const>, RuntimeValue*& result) {
+		result = visitor->allocate_value(new RuntimeValue(flx_bool(visitor->gc.enable)));
 
-		};
+		});
 
-	visitor->builtin_functions["gc_enable"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("enable"))->get_value();
+	visitor->register_builtin("gc_enable", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
 		visitor->gc.enable = val->get_b();
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		};
+		});
 
-	visitor->builtin_functions["gc_collect"] = [this, visitor]() {
-
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+	visitor->register_builtin("gc_collect", [this, visitor](std::span<RuntimeValue* const>, RuntimeValue*& result) {
 
 		visitor->gc.collect();
 
-		};
+		// the result is not rooted until the call returns, so it's allocated after collecting
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+
+		});
 
-	visitor->builtin_functions["gc_get_max_heap"] = [this, visitor]() {
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(flx_int(visitor->gc.max_heap)));
+	visitor->register_builtin("gc_get_max_heap", [this, visitor](std::span<RuntimeValue* const>, RuntimeValue*& result) {
+		result = visitor->allocate_value(new RuntimeValue(flx_int(visitor->gc.max_heap)));
 
-		};
+		});
 
-	visitor->builtin_functions["gc_set_max_heap"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("max_heap"))->get_value();
+	visitor->register_builtin("gc_set_max_heap", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
 		visitor->gc.max_heap = val->get_i();
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+
+		});
+
+
+	visitor->register_builtin("create_weak_ref", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto weak_ref = new NativeWeakRef(check_weak_target(args[0]));
+		visitor->gc.add_weak_object(weak_ref);
+
+		result = build_native_object(visitor, weak_ref, "WeakRef");
+
+		});
+
+	visitor->register_builtin("weak_ref_get", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto target = get_native_object<NativeWeakRef>(visitor, args[0])->get();
+
+		result = target ? target : visitor->allocate_value(new RuntimeValue(Type::T_VOID));
+
+		});
+
+	visitor->register_builtin("weak_ref_is_alive", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto target = get_native_object<NativeWeakRef>(visitor, args[0])->get();
+
+		result = visitor->allocate_value(new RuntimeValue(flx_bool(target != nullptr)));
+
+		});
+
+	visitor->register_builtin("create_weak_table", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto table = new NativeWeakTable(args[0]->get_b(), args[1]->get_b());
+		visitor->gc.add_weak_object(table);
+
+		result = build_native_object(visitor, table, "WeakTable");
+
+		});
+
+	visitor->register_builtin("weak_table_set", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto table = get_native_object<NativeWeakTable>(visitor, args[0]);
+		auto key = store_table_key(visitor, table, args[1]);
+		auto value = args[2];
+		if (table->has_weak_values()) {
+			check_weak_target(value);
+		}
+		else if (!value->use_ref) {
+			value = visitor->allocate_value(new RuntimeValue(value));
+		}
+		table->set(key, value);
+
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+
+		});
+
+	visitor->register_builtin("weak_table_get", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto table = get_native_object<NativeWeakTable>(visitor, args[0]);
+		auto value = table->get(args[1]);
+
+		result = value ? value : visitor->allocate_value(new RuntimeValue(Type::T_VOID));
+
+		});
+
+	visitor->register_builtin("weak_table_contains", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto table = get_native_object<NativeWeakTable>(visitor, args[0]);
+
+		result = visitor->allocate_value(new RuntimeValue(flx_bool(table->get(args[1]) != nullptr)));
+
+		});
+
+	visitor->register_builtin("weak_table_remove", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto table = get_native_object<NativeWeakTable>(visitor, args[0]);
+
+		result = visitor->allocate_value(new RuntimeValue(flx_bool(table->remove(args[1]))));
+
+		});
+
+	visitor->register_builtin("weak_table_size", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto table = get_native_object<NativeWeakTable>(visitor, args[0]);
+
+		result = visitor->allocate_value(new RuntimeValue(flx_int(table->size())));
+
+		});
+
+	visitor->register_builtin("weak_table_clear", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		get_native_object<NativeWeakTable>(visitor, args[0])->clear();
+
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		};
+		});
 
 }
@@ -1,12 +1,60 @@
 #ifndef MD_GC_HPP
 #define MD_GC_HPP
 
+#include <map>
+
 #include "module.hpp"
 
 namespace core {
 
 	namespace modules {
 
+		// reference that does not keep its target alive
+		class NativeWeakRef : public runtime::GCWeakObject {
+		private:
+			RuntimeValue* target;
+
+		public:
+			NativeWeakRef(RuntimeValue* target);
+
+			RuntimeValue* get() const;
+
+			virtual std::vector<runtime::GCObject*> get_references() override;
+			virtual std::vector<runtime::GCObject*> get_conditional_references() override;
+			virtual void clear_dead_references() override;
+		};
+
+		// table with weak keys (ephemeron), weak values or both
+		// weak keys are compared by identity, strong keys by value
+		class NativeWeakTable : public runtime::GCWeakObject {
+		private:
+			struct KeyLess {
+				bool identity;
+				bool operator()(RuntimeValue* lkey, RuntimeValue* rkey) const;
+			};
+
+			bool weak_keys;
+			bool weak_values;
+			std::map<RuntimeValue*, RuntimeValue*, KeyLess> entries;
+
+		public:
+			NativeWeakTable(bool weak_keys, bool weak_values);
+
+			bool has_weak_keys() const;
+			bool has_weak_values() const;
+
+			void set(RuntimeValue* key, RuntimeValue* value);
+			RuntimeValue* get(RuntimeValue* key) const;
+			bool remove(RuntimeValue* key);
+
+			size_t size() const;
+			void clear();
+
+			virtual std::vector<runtime::GCObject*> get_references() override;
+			virtual std::vector<runtime::GCObject*> get_conditional_references() override;
+			virtual void clear_dead_references() override;
+		};
+
 		class ModuleGC : public Module {
 		public:
 			ModuleGC();
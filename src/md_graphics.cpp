@@ -45,12 +45,11 @@ void ModuleGraphics::register_functions(SemanticAnalyser* visitor) {
 
 void ModuleGraphics::register_functions(Interpreter* visitor) {
 
-	visitor->builtin_functions["create_window"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
+	visitor->register_builtin("create_window", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
 		auto vals = std::vector{
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("title"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("width"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("height"))->get_value()
+			args[0],
+			args[1],
+			args[2]
 		};
 
 		// initialize window struct values
@@ -78,108 +77,103 @@ void ModuleGraphics::register_functions(Interpreter* visitor) {
 			win->set_null();
 		}
 
-		visitor->current_expression_value = win;
+		result = win;
 
-		};
+		});
 
-	visitor->builtin_functions["clear_screen"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
+	visitor->register_builtin("clear_screen", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
 		auto vals = std::vector{
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("window"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("color"))->get_value()
+			args[0],
+			args[1]
 		};
 
 		RuntimeValue* win = vals[0];
 		if (TypeUtils::is_void(win->type)) {
 			throw std::runtime_error("Window is null");
 		}
-		if (!win->get_str()[INSTANCE_ID_NAME]->get_i()) {
+		if (!win->find_sub(INSTANCE_ID_NAME)->get_i()) {
 			throw std::runtime_error("Window is corrupted");
 		}
 		int r, g, b;
-		r = (int)vals[1]->get_str()["r"]->get_i();
-		g = (int)vals[1]->get_str()["g"]->get_i();
-		b = (int)vals[1]->get_str()["b"]->get_i();
-		((Window*)win->get_str()[INSTANCE_ID_NAME]->get_i())->clear_screen(Color(r, g, b));
+		r = (int)vals[1]->find_sub("r")->get_i();
+		g = (int)vals[1]->find_sub("g")->get_i();
+		b = (int)vals[1]->find_sub("b")->get_i();
+		((Window*)win->find_sub(INSTANCE_ID_NAME)->get_i())->clear_screen(Color(r, g, b));
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		};
+		});
 
-	visitor->builtin_functions["get_current_width"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("window"))->get_value();
+	visitor->register_builtin("get_current_width", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
 		RuntimeValue* win = val;
 		if (TypeUtils::is_void(win->type)) {
 			throw std::runtime_error("Window is null");
 		}
-		if (!win->get_str()[INSTANCE_ID_NAME]->get_i()) {
+		if (!win->find_sub(INSTANCE_ID_NAME)->get_i()) {
 			throw std::runtime_error("Window is corrupted");
 		}
-		visitor->current_expression_value=visitor->allocate_value(new RuntimeValue(flx_int(((Window*)win->get_str()[INSTANCE_ID_NAME]->get_i())->get_width())));
+		result=visitor->allocate_value(new RuntimeValue(flx_int(((Window*)win->find_sub(INSTANCE_ID_NAME)->get_i())->get_width())));
 
-		};
+		});
 
-	visitor->builtin_functions["get_current_height"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("window"))->get_value();
+	visitor->register_builtin("get_current_height", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
 		RuntimeValue* win = val;
 		if (TypeUtils::is_void(win->type)) {
 			throw std::runtime_error("Window is null");
 		}
-		if (!win->get_str()[INSTANCE_ID_NAME]->get_i()) {
+		if (!win->find_sub(INSTANCE_ID_NAME)->get_i()) {
 			throw std::runtime_error("Window is corrupted");
 		}
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(flx_int(((Window*)win->get_str()[INSTANCE_ID_NAME]->get_i())->get_height())));
+		result = visitor->allocate_value(new RuntimeValue(flx_int(((Window*)win->find_sub(INSTANCE_ID_NAME)->get_i())->get_height())));
 
-		};
+		});
 
-	visitor->builtin_functions["draw_pixel"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
+	visitor->register_builtin("draw_pixel", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
 		auto vals = std::vector{
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("window"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("x"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("y"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("color"))->get_value()
+			args[0],
+			args[1],
+			args[2],
+			args[3]
 		};
 
 		RuntimeValue* win = vals[0];
 		if (TypeUtils::is_void(win->type)) {
 			throw std::runtime_error("Window is null");
 		}
-		if (!win->get_str()[INSTANCE_ID_NAME]->get_i()) {
+		if (!win->find_sub(INSTANCE_ID_NAME)->get_i()) {
 			throw std::runtime_error("Window is corrupted");
 		}
 		int x, y, r, g, b;
 		x = (int)vals[1]->get_i();
 		y = (int)vals[2]->get_i();
-		r = (int)vals[3]->get_str()["r"]->get_i();
-		g = (int)vals[3]->get_str()["g"]->get_i();
-		b = (int)vals[3]->get_str()["b"]->get_i();
-		((Window*)win->get_str()[INSTANCE_ID_NAME]->get_i())->draw_pixel(x, y, Color(r, g, b));
+		r = (int)vals[3]->find_sub("r")->get_i();
+		g = (int)vals[3]->find_sub("g")->get_i();
+		b = (int)vals[3]->find_sub("b")->get_i();
+		((Window*)win->find_sub(INSTANCE_ID_NAME)->get_i())->draw_pixel(x, y, Color(r, g, b));
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		};
+		});
 
-	visitor->builtin_functions["draw_line"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
+	visitor->register_builtin("draw_line", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
 		auto vals = std::vector{
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("window"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("x1"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("y1"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("x2"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("y2"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("color"))->get_value()
+			args[0],
+			args[1],
+			args[2],
+			args[3],
+			args[4],
+			args[5]
 		};
 
 		RuntimeValue* win = vals[0];
 		if (TypeUtils::is_void(win->type)) {
 			throw std::runtime_error("Window is null");
 		}
-		if (!win->get_str()[INSTANCE_ID_NAME]->get_i()) {
+		if (!win->find_sub(INSTANCE_ID_NAME)->get_i()) {
 			throw std::runtime_error("Window is corrupted");
 		}
 		int x1, y1, x2, y2, r, g, b;
@@ -187,31 +181,30 @@ void ModuleGraphics::register_functions(Interpreter* visitor) {
 		y1 = (int)vals[2]->get_i();
 		x2 = (int)vals[3]->get_i();
 		y2 = (int)vals[4]->get_i();
-		r = (int)vals[5]->get_str()["r"]->get_i();
-		g = (int)vals[5]->get_str()["g"]->get_i();
-		b = (int)vals[5]->get_str()["b"]->get_i();
-		((Window*)win->get_str()[INSTANCE_ID_NAME]->get_i())->draw_line(x1, y1, x2, y2, Color(r, g, b));
+		r = (int)vals[5]->find_sub("r")->get_i();
+		g = (int)vals[5]->find_sub("g")->get_i();
+		b = (int)vals[5]->find_sub("b")->get_i();
+		((Window*)win->find_sub(INSTANCE_ID_NAME)->get_i())->draw_line(x1, y1, x2, y2, Color(r, g, b));
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		};
+		});
 
-	visitor->builtin_functions["draw_rect"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
+	visitor->register_builtin("draw_rect", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
 		auto vals = std::vector{
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("window"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("x"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("y"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("width"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("height"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("color"))->get_value()
+			args[0],
+			args[1],
+			args[2],
+			args[3],
+			args[4],
+			args[5]
 		};
 
 		RuntimeValue* win = vals[0];
 		if (TypeUtils::is_void(win->type)) {
 			throw std::runtime_error("Window is null");
 		}
-		if (!((Window*)win->get_str()[INSTANCE_ID_NAME]->get_i())) {
+		if (!((Window*)win->find_sub(INSTANCE_ID_NAME)->get_i())) {
 			throw std::runtime_error("Window is corrupted");
 		}
 		int x, y, width, height, r, g, b;
@@ -219,31 +212,30 @@ void ModuleGraphics::register_functions(Interpreter* visitor) {
 		y = (int)vals[2]->get_i();
 		width = (int)vals[3]->get_i();
 		height = (int)vals[4]->get_i();
-		r = (int)vals[5]->get_str()["r"]->get_i();
-		g = (int)vals[5]->get_str()["g"]->get_i();
-		b = (int)vals[5]->get_str()["b"]->get_i();
-		((Window*)win->get_str()[INSTANCE_ID_NAME]->get_i())->draw_rect(x, y, width, height, Color(r, g, b));
+		r = (int)vals[5]->find_sub("r")->get_i();
+		g = (int)vals[5]->find_sub("g")->get_i();
+		b = (int)vals[5]->find_sub("b")->get_i();
+		((Window*)win->find_sub(INSTANCE_ID_NAME)->get_i())->draw_rect(x, y, width, height, Color(r, g, b));
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		};
+		});
 
-	visitor->builtin_functions["fill_rect"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
+	visitor->register_builtin("fill_rect", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
 		auto vals = std::vector{
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("window"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("x"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("y"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("width"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("height"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("color"))->get_value()
+			args[0],
+			args[1],
+			args[2],
+			args[3],
+			args[4],
+			args[5]
 		};
 
 		RuntimeValue* win = vals[0];
 		if (TypeUtils::is_void(win->type)) {
 			throw std::runtime_error("Window is null");
 		}
-		if (!((Window*)win->get_str()[INSTANCE_ID_NAME]->get_i())) {
+		if (!((Window*)win->find_sub(INSTANCE_ID_NAME)->get_i())) {
 			throw std::runtime_error("Window is corrupted");
 		}
 		int x, y, width, height, r, g, b;
@@ -251,85 +243,82 @@ void ModuleGraphics::register_functions(Interpreter* visitor) {
 		y = (int)vals[2]->get_i();
 		width = (int)vals[3]->get_i();
 		height = (int)vals[4]->get_i();
-		r = (int)vals[5]->get_str()["r"]->get_i();
-		g = (int)vals[5]->get_str()["g"]->get_i();
-		b = (int)vals[5]->get_str()["b"]->get_i();
-		((Window*)win->get_str()[INSTANCE_ID_NAME]->get_i())->fill_rect(x, y, width, height, Color(r, g, b));
+		r = (int)vals[5]->find_sub("r")->get_i();
+		g = (int)vals[5]->find_sub("g")->get_i();
+		b = (int)vals[5]->find_sub("b")->get_i();
+		((Window*)win->find_sub(INSTANCE_ID_NAME)->get_i())->fill_rect(x, y, width, height, Color(r, g, b));
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		};
+		});
 
-	visitor->builtin_functions["draw_circle"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
+	visitor->register_builtin("draw_circle", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
 		auto vals = std::vector{
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("window"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("xc"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("yc"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("radius"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("color"))->get_value()
+			args[0],
+			args[1],
+			args[2],
+			args[3],
+			args[4]
 		};
 
 		RuntimeValue* win = vals[0];
 		if (TypeUtils::is_void(win->type)) {
 			throw std::runtime_error("Window is null");
 		}
-		if (!((Window*)win->get_str()[INSTANCE_ID_NAME]->get_i())) {
+		if (!((Window*)win->find_sub(INSTANCE_ID_NAME)->get_i())) {
 			throw std::runtime_error("Window is corrupted");
 		}
 		int xc, yc, radius, r, g, b;
 		xc = (int)vals[1]->get_i();
 		yc = (int)vals[2]->get_i();
 		radius = (int)vals[3]->get_i();
-		r = (int)vals[4]->get_str()["r"]->get_i();
-		g = (int)vals[4]->get_str()["g"]->get_i();
-		b = (int)vals[4]->get_str()["b"]->get_i();
-		((Window*)win->get_str()[INSTANCE_ID_NAME]->get_i())->draw_circle(xc, yc, radius, Color(r, g, b));
+		r = (int)vals[4]->find_sub("r")->get_i();
+		g = (int)vals[4]->find_sub("g")->get_i();
+		b = (int)vals[4]->find_sub("b")->get_i();
+		((Window*)win->find_sub(INSTANCE_ID_NAME)->get_i())->draw_circle(xc, yc, radius, Color(r, g, b));
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		};
+		});
 
-	visitor->builtin_functions["fill_circle"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
+	visitor->register_builtin("fill_circle", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
 		auto vals = std::vector{
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("window"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("xc"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("yc"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("radius"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("color"))->get_value()
+			args[0],
+			args[1],
+			args[2],
+			args[3],
+			args[4]
 		};
 
 		RuntimeValue* win = vals[0];
 		if (TypeUtils::is_void(win->type)) {
 			throw std::runtime_error("Window is null");
 		}
-		if (!((Window*)win->get_str()[INSTANCE_ID_NAME]->get_i())) {
+		if (!((Window*)win->find_sub(INSTANCE_ID_NAME)->get_i())) {
 			throw std::runtime_error("Window is corrupted");
 		}
 		int xc, yc, radius, r, g, b;
 		xc = (int)vals[1]->get_i();
 		yc = (int)vals[2]->get_i();
 		radius = (int)vals[3]->get_i();
-		r = (int)vals[4]->get_str()["r"]->get_i();
-		g = (int)vals[4]->get_str()["g"]->get_i();
-		b = (int)vals[4]->get_str()["b"]->get_i();
-		((Window*)win->get_str()[INSTANCE_ID_NAME]->get_i())->fill_circle(xc, yc, radius, Color(r, g, b));
+		r = (int)vals[4]->find_sub("r")->get_i();
+		g = (int)vals[4]->find_sub("g")->get_i();
+		b = (int)vals[4]->find_sub("b")->get_i();
+		((Window*)win->find_sub(INSTANCE_ID_NAME)->get_i())->fill_circle(xc, yc, radius, Color(r, g, b));
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		};
+		});
 
-	visitor->builtin_functions["create_font"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
+	visitor->register_builtin("create_font", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
 		auto vals = std::vector{
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("size"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("name"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("weight"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("italic"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("underline"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("strike"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("orientation"))->get_value()
+			args[0],
+			args[1],
+			args[2],
+			args[3],
+			args[4],
+			args[5],
+			args[6]
 		};
 
 		// initialize image struct values
@@ -361,76 +350,74 @@ void ModuleGraphics::register_functions(Interpreter* visitor) {
 
 		font_value->set(str, "Font", Constants::STD_NAMESPACE);
 
-		visitor->current_expression_value = font_value;
+		result = font_value;
 
-		};
+		});
 
-	visitor->builtin_functions["draw_text"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
+	visitor->register_builtin("draw_text", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
 		auto vals = std::vector{
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("window"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("x"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("y"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("text"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("color"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("font"))->get_value()
+			args[0],
+			args[1],
+			args[2],
+			args[3],
+			args[4],
+			args[5]
 		};
 
 		RuntimeValue* win = vals[0];
 		if (TypeUtils::is_void(win->type)) {
 			throw std::runtime_error("Window is null");
 		}
-		if (!((Window*)win->get_str()[INSTANCE_ID_NAME]->get_i())) {
+		if (!((Window*)win->find_sub(INSTANCE_ID_NAME)->get_i())) {
 			throw std::runtime_error("Window is corrupted");
 		}
 		int x = (int)vals[1]->get_i();
 		int y = (int)vals[2]->get_i();
-		std::string text = vals[3]->get_s();
-		int r = (int)vals[4]->get_str()["r"]->get_i();
-		int g = (int)vals[4]->get_str()["g"]->get_i();
-		int b = (int)vals[4]->get_str()["b"]->get_i();
+		const std::string& text = vals[3]->get_s();
+		int r = (int)vals[4]->find_sub("r")->get_i();
+		int g = (int)vals[4]->find_sub("g")->get_i();
+		int b = (int)vals[4]->find_sub("b")->get_i();
 
 		RuntimeValue* font_value = vals[5];
 		if (TypeUtils::is_void(font_value->type)) {
 			throw std::runtime_error("font is null");
 		}
-		Font* font = (Font*)font_value->get_str()[INSTANCE_ID_NAME]->get_i();
+		Font* font = (Font*)font_value->find_sub(INSTANCE_ID_NAME)->get_i();
 		if (!font) {
 			throw std::runtime_error("there was an error handling font");
 		}
 
-		((Window*)win->get_str()[INSTANCE_ID_NAME]->get_i())->draw_text(x, y, text, Color(r, g, b), font);
+		((Window*)win->find_sub(INSTANCE_ID_NAME)->get_i())->draw_text(x, y, text, Color(r, g, b), font);
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		};
+		});
 
-	visitor->builtin_functions["get_text_size"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
+	visitor->register_builtin("get_text_size", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
 		auto vals = std::vector{
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("window"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("text"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("font"))->get_value()
+			args[0],
+			args[1],
+			args[2]
 		};
 
 		RuntimeValue* win = vals[0];
 		if (TypeUtils::is_void(win->type)) {
 			throw std::runtime_error("Window is null");
 		}
-		if (!((Window*)win->get_str()[INSTANCE_ID_NAME]->get_i())) {
+		if (!((Window*)win->find_sub(INSTANCE_ID_NAME)->get_i())) {
 			throw std::runtime_error("Window is corrupted");
 		}
-		std::string text = vals[1]->get_s();
+		const std::string& text = vals[1]->get_s();
 		RuntimeValue* font_value = vals[2];
 		if (TypeUtils::is_void(font_value->type)) {
 			throw std::runtime_error("font is null");
 		}
-		Font* font = (Font*)font_value->get_str()[INSTANCE_ID_NAME]->get_i();
+		Font* font = (Font*)font_value->find_sub(INSTANCE_ID_NAME)->get_i();
 		if (!font) {
 			throw std::runtime_error("there was an error handling font");
 		}
 
-		auto point = ((Window*)win->get_str()[INSTANCE_ID_NAME]->get_i())->get_text_size(text, font);
+		auto point = ((Window*)win->find_sub(INSTANCE_ID_NAME)->get_i())->get_text_size(text, font);
 
 		flx_struct str = flx_struct();
 		str["width"] = visitor->allocate_value(new RuntimeValue(flx_int(point.width * 2 * 0.905)));
@@ -438,13 +425,12 @@ void ModuleGraphics::register_functions(Interpreter* visitor) {
 
 		RuntimeValue* res = visitor->allocate_value(new RuntimeValue(str, "Size", Constants::STD_NAMESPACE));
 
-		visitor->current_expression_value = res;
+		result = res;
 
-		};
+		});
 
-	visitor->builtin_functions["load_image"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("path"))->get_value();
+	visitor->register_builtin("load_image", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
 		// initialize image struct values
 		RuntimeValue* img = visitor->allocate_value(new RuntimeValue(Type::T_STRUCT));
@@ -467,24 +453,23 @@ void ModuleGraphics::register_functions(Interpreter* visitor) {
 
 		img->set(str, "Image", Constants::STD_NAMESPACE);
 
-		visitor->current_expression_value = img;
+		result = img;
 
-		};
+		});
 
-	visitor->builtin_functions["draw_image"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
+	visitor->register_builtin("draw_image", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
 		auto vals = std::vector{
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("window"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("image"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("x"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("y"))->get_value()
+			args[0],
+			args[1],
+			args[2],
+			args[3]
 		};
 
 		RuntimeValue* win = vals[0];
 		if (TypeUtils::is_void(win->type)) {
 			throw std::runtime_error("window is null");
 		}
-		auto window = ((Window*)win->get_str()[INSTANCE_ID_NAME]->get_i());
+		auto window = ((Window*)win->find_sub(INSTANCE_ID_NAME)->get_i());
 		if (!window) {
 			throw std::runtime_error("there was an error handling window");
 		}
@@ -492,7 +477,7 @@ void ModuleGraphics::register_functions(Interpreter* visitor) {
 		if (TypeUtils::is_void(img->type)) {
 			throw std::runtime_error("window is null");
 		}
-		auto image = ((Image*)img->get_str()[INSTANCE_ID_NAME]->get_i());
+		auto image = ((Image*)img->find_sub(INSTANCE_ID_NAME)->get_i());
 		if (!image) {
 			throw std::runtime_error("there was an error handling image");
 		}
@@ -500,83 +485,78 @@ void ModuleGraphics::register_functions(Interpreter* visitor) {
 		int y = (int)vals[3]->get_i();
 		window->draw_image(image, x, y);
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		};
+		});
 
-	visitor->builtin_functions["update"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("window"))->get_value();
+	visitor->register_builtin("update", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
 		RuntimeValue* win = val;
 		if (!TypeUtils::is_void(win->type)) {
-			if (((Window*)win->get_str()[INSTANCE_ID_NAME]->get_i())) {
-				((Window*)win->get_str()[INSTANCE_ID_NAME]->get_i())->update();
+			if (((Window*)win->find_sub(INSTANCE_ID_NAME)->get_i())) {
+				((Window*)win->find_sub(INSTANCE_ID_NAME)->get_i())->update();
 			}
 		}
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		};
+		});
 
-	visitor->builtin_functions["destroy_window"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("window"))->get_value();
+	visitor->register_builtin("destroy_window", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
 		RuntimeValue* win = val;
 		if (!TypeUtils::is_void(win->type)) {
-			Window* window = (Window*)win->get_str()[INSTANCE_ID_NAME]->get_i();
+			Window* window = (Window*)win->find_sub(INSTANCE_ID_NAME)->get_i();
 			if (window) {
 				delete window;
 				win->set_null();
 			}
 		}
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		};
+		});
 
-	visitor->builtin_functions["destroy_font"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("font"))->get_value();
+	visitor->register_builtin("destroy_font", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
 		RuntimeValue* font_value = val;
 		if (!TypeUtils::is_void(font_value->type)) {
-			Font* font = (Font*)font_value->get_str()[INSTANCE_ID_NAME]->get_i();
+			Font* font = (Font*)font_value->find_sub(INSTANCE_ID_NAME)->get_i();
 			if (font) {
 				delete font;
 				font_value->set_null();
 			}
 		}
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		};
+		});
 
-	visitor->builtin_functions["destroy_image"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("image"))->get_value();
+	visitor->register_builtin("destroy_image", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
 		RuntimeValue* img_value = val;
 		if (!TypeUtils::is_void(img_value->type)) {
-			Image* img = (Image*)img_value->get_str()[INSTANCE_ID_NAME]->get_i();
+			Image* img = (Image*)img_value->find_sub(INSTANCE_ID_NAME)->get_i();
 			if (img) {
 				delete img;
 				img_value->set_null();
 			}
 		}
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		};
+		});
 
-	visitor->builtin_functions["is_quit"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		RuntimeValue* win = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("window"))->get_value();
+	visitor->register_builtin("is_quit", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		RuntimeValue* win = args[0];
 		auto val = visitor->allocate_value(new RuntimeValue(Type::T_BOOL));
 		if (!TypeUtils::is_void(win->type)) {
-			if (((Window*)win->get_str()[INSTANCE_ID_NAME]->get_i())) {
-				val->set(flx_bool(((Window*)win->get_str()[INSTANCE_ID_NAME]->get_i())->is_quit()));
+			if (((Window*)win->find_sub(INSTANCE_ID_NAME)->get_i())) {
+				val->set(flx_bool(((Window*)win->find_sub(INSTANCE_ID_NAME)->get_i())->is_quit()));
 			}
 			else {
 				val->set(flx_bool(true));
@@ -585,7 +565,7 @@ void ModuleGraphics::register_functions(Interpreter* visitor) {
 		else {
 			val->set(flx_bool(true));
 		}
-		visitor->current_expression_value = val;
+		result = val;
 
-		};
+		});
 }
@@ -35,22 +35,20 @@ void ModuleHTTP::register_functions(SemanticAnalyser* visitor) {
 
 void ModuleHTTP::register_functions(Interpreter* visitor) {
 
-	visitor->builtin_functions["request"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("req"))->get_value();
+	visitor->register_builtin("request", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
 		RuntimeValue* config_value = val;
 		if (TypeUtils::is_void(config_value->type)) {
 			throw std::runtime_error("'req' is null");
 		}
-		flx_struct config_str = config_value->get_str();
-		std::string hostname = config_str["hostname"]->get_s();
-		std::string path = config_str["path"]->get_s();
-		std::string method = config_str["method"]->get_s();
+		const std::string& hostname = config_value->find_sub("hostname")->get_s();
+		std::string path = config_value->find_sub("path")->get_s();
+		const std::string& method = config_value->find_sub("method")->get_s();
 		std::string port = "80";
 		std::string headers = "";
 		std::string parameters = "";
-		std::string data = config_str["data"]->get_s();
+		const std::string& data = config_value->find_sub("data")->get_s();
 
 		// check mandatory parameters
 		if (hostname.empty()) {
@@ -66,14 +64,13 @@ void ModuleHTTP::register_functions(Interpreter* visitor) {
 		}
 
 		// get port
-		int param_port = config_str["port"]->get_i();
+		int param_port = config_value->find_sub("port")->get_i();
 		if (param_port  != 0) {
 			port = std::to_string(param_port);
 		}
 
 		// build parameters
-		flx_struct str_parameters = config_str["parameters"]->get_str();
-		for (auto parameter : str_parameters) {
+		for (const auto& parameter : config_value->find_sub("parameters")->get_str()) {
 			if (parameters.empty()) {
 				parameters = "?";
 			}
@@ -84,8 +81,7 @@ void ModuleHTTP::register_functions(Interpreter* visitor) {
 		}
 
 		// build headers
-		flx_struct str_headers = config_str["headers"]->get_str();
-		for (auto header : str_headers) {
+		for (const auto& header : config_value->find_sub("headers")->get_str()) {
 			headers += header.first + ": " + header.second->get_s() + "\r\n";
 		}
 
@@ -93,7 +89,7 @@ void ModuleHTTP::register_functions(Interpreter* visitor) {
 
 		int sock;
 		struct addrinfo hints;
-		struct addrinfo* result = nullptr;
+		struct addrinfo* address = nullptr;
 
 		// set hints to DNS resolution
 		memset(&hints, 0, sizeof(hints));
@@ -102,21 +98,21 @@ void ModuleHTTP::register_functions(Interpreter* visitor) {
 		hints.ai_protocol = IPPROTO_TCP;
 
 		// resolve DNS
-		if (getaddrinfo(hostname.c_str(), port.c_str(), &hints, &result) != 0) {
+		if (getaddrinfo(hostname.c_str(), port.c_str(), &hints, &address) != 0) {
 			throw std::runtime_error("Failed to resolve hostname.");
 		}
 
 		// create socket
-		sock = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+		sock = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
 		if (sock < 0) {
-			freeaddrinfo(result);
+			freeaddrinfo(address);
 			throw std::runtime_error("Socket creation failed.");
 		}
 
 		// connect to server
-		if (connect(sock, result->ai_addr, result->ai_addrlen) < 0) {
+		if (connect(sock, address->ai_addr, address->ai_addrlen) < 0) {
 			close(sock);
-			freeaddrinfo(result);
+			freeaddrinfo(address);
 			throw std::runtime_error("Connection failed.");
 		}
 		
@@ -125,7 +121,7 @@ void ModuleHTTP::register_functions(Interpreter* visitor) {
 		WSADATA wsa;
 		SOCKET sock;
 		struct sockaddr_in server;
-		struct addrinfo* result = NULL;
+		struct addrinfo* address = NULL;
 		struct addrinfo hints;
 
 		if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) {
@@ -139,23 +135,23 @@ void ModuleHTTP::register_functions(Interpreter* visitor) {
 		hints.ai_protocol = IPPROTO_TCP;
 
 		// resolve DNS
-		if (getaddrinfo(hostname.c_str(), port.c_str(), &hints, &result) != 0) {
+		if (getaddrinfo(hostname.c_str(), port.c_str(), &hints, &address) != 0) {
 			WSACleanup();
 			throw std::runtime_error("Failed to resolve hostname.");
 		}
 
 		// create socket
-		sock = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+		sock = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
 		if (sock == INVALID_SOCKET) {
-			freeaddrinfo(result);
+			freeaddrinfo(address);
 			WSACleanup();
 			throw std::runtime_error("Socket creation failed. Error: " + WSAGetLastError());
 		}
 
 		// connect to server
-		if (connect(sock, result->ai_addr, (int)result->ai_addrlen) == SOCKET_ERROR) {
+		if (connect(sock, address->ai_addr, (int)address->ai_addrlen) == SOCKET_ERROR) {
 			closesocket(sock);
-			freeaddrinfo(result);
+			freeaddrinfo(address);
 			WSACleanup();
 			throw std::runtime_error("Connection failed. Error: " + WSAGetLastError());
 		}
@@ -198,7 +194,7 @@ void ModuleHTTP::register_functions(Interpreter* visitor) {
 #elif defined(_WIN32) || defined(WIN32)
 		
 		closesocket(sock);
-		freeaddrinfo(result);
+		freeaddrinfo(address);
 		WSACleanup();
 		
 #endif // linux
@@ -220,9 +216,7 @@ void ModuleHTTP::register_functions(Interpreter* visitor) {
 		res_headers_str["root"] = visitor->allocate_value(new RuntimeValue(Type::T_VOID));
 		res_headers_str["size"] = visitor->allocate_value(new RuntimeValue(flx_int(0)));
 		auto headers_value = visitor->allocate_value(new RuntimeValue(res_headers_str, "Dictionary", Constants::STD_NAMESPACE));
-		// dict identifier
-		auto header_identifier = std::make_shared<ASTIdentifierNode>(std::vector<Identifier>{ Identifier("headers_value") }, Constants::STD_NAMESPACE, 0, 0);
-		
+
 		// create dict expr
 		auto dict_expr = std::make_shared<ASTValueNode>(headers_value, 0, 0);
 
@@ -230,10 +224,9 @@ void ModuleHTTP::register_functions(Interpreter* visitor) {
 		(std::make_shared<ASTDeclarationNode>("headers_value", Type::T_STRUCT, Type::T_UNDEFINED, std::vector<std::shared_ptr<ASTExprNode>>(),
 			"Dictionary", Constants::STD_NAMESPACE, dict_expr, false, 0, 0))->accept(visitor);
 
-		// dictionary emplace function declaration
-		auto identifier_vector = std::vector<Identifier>{ Identifier("emplace") };
-		auto fcall = std::make_shared<ASTFunctionCallNode>(Constants::STD_NAMESPACE, identifier_vector,
-			std::vector<std::shared_ptr<ASTExprNode>>(), std::vector<Identifier>(), nullptr, 0, 0);
+		// dictionary emplace function
+		auto emplace = flx_function(Constants::STD_NAMESPACE, "emplace");
+		auto headers_var = std::dynamic_pointer_cast<RuntimeVariable>(curr_scope->find_declared_variable("headers_value"));
 
 		for (size_t i = 1; i < response_lines.size(); ++i) {
 			auto& line = response_lines[i];
@@ -246,20 +239,16 @@ void ModuleHTTP::register_functions(Interpreter* visitor) {
 					continue;
 				}
 
-				// setup emplace parameters
+				// call emplace with the dictionary, key and value
 				auto header = utils::StringUtils::split(line, ": ");
-				auto parameters = std::vector<std::shared_ptr<ASTExprNode>> {
-					// dictionary
-					header_identifier,
-					// key
-					std::make_shared<ASTLiteralNode<flx_string>>(header[0], 0, 0),
-					// value
-					std::make_shared<ASTLiteralNode<flx_string>>(header[1], 0, 0)
+				auto dict = headers_var->get_value();
+				dict->reset_ref();
+				RuntimeValue* arguments[] = {
+					dict,
+					visitor->allocate_value(new RuntimeValue(flx_string(header[0]))),
+					visitor->allocate_value(new RuntimeValue(flx_string(header[1])))
 				};
-
-				// call emplace
-				fcall->parameters = parameters;
-				fcall->accept(visitor);
+				visitor->call(emplace, arguments);
 
 			}
 		}
@@ -274,11 +263,11 @@ void ModuleHTTP::register_functions(Interpreter* visitor) {
 		res_str["data"] = visitor->allocate_value(new RuntimeValue(flx_string(res_body)));
 		res_str["raw"] = visitor->allocate_value(new RuntimeValue(flx_string(raw_response)));
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(res_str, "HttpResponse", Constants::STD_NAMESPACE));
+		result = visitor->allocate_value(new RuntimeValue(res_str, "HttpResponse", Constants::STD_NAMESPACE));
 
 		// remove scope
 		visitor->scopes[Constants::STD_NAMESPACE].pop_back();
 
-		};
+		});
 
 }
@@ -31,9 +31,9 @@ void ModuleInput::register_functions(SemanticAnalyser* visitor) {
 
 void ModuleInput::register_functions(Interpreter* visitor) {
 
-	visitor->builtin_functions["update_key_states"] = [this, visitor]() {
+	visitor->register_builtin("update_key_states", [this, visitor](std::span<RuntimeValue* const>, RuntimeValue*& result) {
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
 #ifdef linux
 
@@ -49,9 +49,9 @@ void ModuleInput::register_functions(Interpreter* visitor) {
 
 #endif // linux
 
-	};
+		});
 
-	visitor->builtin_functions["is_key_pressed"] = [this, visitor]() {
+	visitor->register_builtin("is_key_pressed", [this, visitor]([[maybe_unused]] std::span<RuntimeValue* const> args, RuntimeValue*& result) {
 		bool is_pressed = false;
 
 #ifdef linux
@@ -60,8 +60,7 @@ void ModuleInput::register_functions(Interpreter* visitor) {
 		
 #elif  defined(_WIN32) || defined(WIN32)
 
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("key"))->get_value();
+		auto val = args[0];
 
 		int key = val->get_i();
 
@@ -72,11 +71,11 @@ void ModuleInput::register_functions(Interpreter* visitor) {
 
 #endif // linux
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(flx_bool(is_pressed)));
+		result = visitor->allocate_value(new RuntimeValue(flx_bool(is_pressed)));
 
-		};
+		});
 
-	visitor->builtin_functions["is_key_released"] = [this, visitor]() {
+	visitor->register_builtin("is_key_released", [this, visitor]([[maybe_unused]] std::span<RuntimeValue* const> args, RuntimeValue*& result) {
 		bool is_released = false;
 
 #ifdef linux
@@ -84,8 +83,7 @@ void ModuleInput::register_functions(Interpreter* visitor) {
 		throw std::runtime_error("Not implemented yet");
 				
 #elif  defined(_WIN32) || defined(WIN32)
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("key"))->get_value();
+		auto val = args[0];
 
 		int key = val->get_i();
 
@@ -99,11 +97,11 @@ void ModuleInput::register_functions(Interpreter* visitor) {
 		
 #endif // linux
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(flx_bool(is_released)));
+		result = visitor->allocate_value(new RuntimeValue(flx_bool(is_released)));
 
-		};
+		});
 
-	visitor->builtin_functions["get_mouse_position"] = [this, visitor]() {
+	visitor->register_builtin("get_mouse_position", [this, visitor](std::span<RuntimeValue* const>, RuntimeValue*& result) {
 
 		long long x, y = 0;
 
@@ -125,13 +123,13 @@ void ModuleInput::register_functions(Interpreter* visitor) {
 		str["y"] = visitor->allocate_value(new RuntimeValue(flx_int(y * 2 * 0.875)));
 		RuntimeValue* res = visitor->allocate_value(new RuntimeValue(str, "Point", Constants::STD_NAMESPACE));
 
-		visitor->current_expression_value = res;
+		result = res;
 
-		};
+		});
 
-	visitor->builtin_functions["set_mouse_position"] = [this, visitor]() {
+	visitor->register_builtin("set_mouse_position", [this, visitor]([[maybe_unused]] std::span<RuntimeValue* const> args, RuntimeValue*& result) {
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
 #ifdef linux
 		
@@ -139,10 +137,9 @@ void ModuleInput::register_functions(Interpreter* visitor) {
 						
 #elif  defined(_WIN32) || defined(WIN32)
 
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
 		auto vals = std::vector{
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("x"))->get_value(),
-			std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("y"))->get_value()
+			args[0],
+			args[1]
 		};
 
 		int x = vals[0]->get_i();
@@ -151,9 +148,9 @@ void ModuleInput::register_functions(Interpreter* visitor) {
 
 #endif // linux
 
-		};
+		});
 
-	visitor->builtin_functions["is_mouse_button_pressed"] = [this, visitor]() {
+	visitor->register_builtin("is_mouse_button_pressed", [this, visitor]([[maybe_unused]] std::span<RuntimeValue* const> args, RuntimeValue*& result) {
 
 		bool is_pressed = false;
 
@@ -163,8 +160,7 @@ void ModuleInput::register_functions(Interpreter* visitor) {
 								
 #elif  defined(_WIN32) || defined(WIN32)
 		
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("button"))->get_value();
+		auto val = args[0];
 
 		int button = val->get_i();
 		
@@ -172,9 +168,9 @@ void ModuleInput::register_functions(Interpreter* visitor) {
 
 #endif // linux
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(flx_bool(is_pressed)));
+		result = visitor->allocate_value(new RuntimeValue(flx_bool(is_pressed)));
 		
-		};
+		});
 }
 
 void ModuleInput::key_update_loop() {
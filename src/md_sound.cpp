@@ -28,11 +28,10 @@ void ModuleSound::register_functions(SemanticAnalyser* visitor) {
 
 void ModuleSound::register_functions(Interpreter* visitor) {
 
-	visitor->builtin_functions["play_sound"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("path"))->get_value();
+	visitor->register_builtin("play_sound", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
-		auto file_path = val->get_s();
+		const auto& file_path = val->get_s();
 		std::wstring wfile_path = std::wstring(file_path.begin(), file_path.end());
 
 #ifdef linux
@@ -45,15 +44,14 @@ void ModuleSound::register_functions(Interpreter* visitor) {
 
 #endif // linux
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		};
+		});
 
-	visitor->builtin_functions["play_sound_once"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("path"))->get_value();
+	visitor->register_builtin("play_sound_once", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
-		auto file_path = val->get_s();
+		const auto& file_path = val->get_s();
 		std::wstring wfile_path = std::wstring(file_path.begin(), file_path.end());
 
 #ifdef linux
@@ -66,11 +64,11 @@ void ModuleSound::register_functions(Interpreter* visitor) {
 
 #endif // linux
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		};
+		});
 
-	visitor->builtin_functions["stop_sound"] = [this, visitor]() {
+	visitor->register_builtin("stop_sound", [this, visitor](std::span<RuntimeValue* const>, RuntimeValue*& result) {
 
 #ifdef linux
 
@@ -82,13 +80,12 @@ void ModuleSound::register_functions(Interpreter* visitor) {
 
 #endif // linux
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		};
+		});
 
-	visitor->builtin_functions["set_volume"] = [this, visitor]() {
-		auto& scope = visitor->scopes[Constants::STD_NAMESPACE].back();
-		auto val = std::dynamic_pointer_cast<RuntimeVariable>(scope->find_declared_variable("volume"))->get_value();
+	visitor->register_builtin("set_volume", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto val = args[0];
 
 		unsigned long volume = val->get_f() * 65535;
 
@@ -102,7 +99,7 @@ void ModuleSound::register_functions(Interpreter* visitor) {
 
 #endif // linux
 
-		visitor->current_expression_value = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
 
-		};
+		});
 }
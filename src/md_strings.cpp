@@ -0,0 +1,98 @@
+#include "md_strings.hpp"
+
+#include "interpreter.hpp"
+#include "semantic_analysis.hpp"
+#include "constants.hpp"
+
+using namespace core;
+using namespace core::modules;
+using namespace core::runtime;
+using namespace core::analysis;
+
+std::vector<GCObject*> NativeStringBuilder::get_references() {
+	return std::vector<GCObject*>();
+}
+
+ModuleStrings::ModuleStrings() {}
+
+ModuleStrings::~ModuleStrings() = default;
+
+void ModuleStrings::register_functions(SemanticAnalyser* visitor) {
+	visitor->builtin_functions["create_string_builder"] = nullptr;
+	visitor->builtin_functions["string_builder_append"] = nullptr;
+	visitor->builtin_functions["string_builder_append_char"] = nullptr;
+	visitor->builtin_functions["string_builder_reserve"] = nullptr;
+	visitor->builtin_functions["string_builder_length"] = nullptr;
+	visitor->builtin_functions["string_builder_to_string"] = nullptr;
+	visitor->builtin_functions["string_builder_clear"] = nullptr;
+}
+
+void ModuleStrings::register_functions(Interpreter* visitor) {
+
+	visitor->register_builtin("create_string_builder", [this, visitor](std::span<RuntimeValue* const>, RuntimeValue*& result) {
+		result = build_native_object(visitor, new NativeStringBuilder(), "StringBuilder");
+
+		});
+
+	visitor->register_builtin("string_builder_append", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto builder = get_native_object<NativeStringBuilder>(visitor, args[0]);
+		auto value = args[1];
+
+		switch (value->type) {
+		case Type::T_STRING:
+			builder->buffer.append(value->get_s());
+			break;
+		case Type::T_CHAR:
+			builder->buffer.push_back(*value->get_raw_c());
+			break;
+		default:
+			builder->buffer.append(RuntimeOperations::parse_value_to_string(value));
+			break;
+		}
+
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+
+		});
+
+	visitor->register_builtin("string_builder_append_char", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto builder = get_native_object<NativeStringBuilder>(visitor, args[0]);
+		builder->buffer.push_back(args[1]->get_c());
+
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+
+		});
+
+	visitor->register_builtin("string_builder_reserve", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto builder = get_native_object<NativeStringBuilder>(visitor, args[0]);
+		auto capacity = args[1]->get_i();
+		if (capacity < 0) {
+			throw std::runtime_error("invalid string builder capacity " + std::to_string(capacity));
+		}
+		builder->buffer.reserve(size_t(capacity));
+
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+
+		});
+
+	visitor->register_builtin("string_builder_length", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto builder = get_native_object<NativeStringBuilder>(visitor, args[0]);
+
+		result = visitor->allocate_value(new RuntimeValue(flx_int(builder->buffer.size())));
+
+		});
+
+	visitor->register_builtin("string_builder_to_string", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		auto builder = get_native_object<NativeStringBuilder>(visitor, args[0]);
+
+		result = visitor->allocate_value(new RuntimeValue(builder->buffer));
+
+		});
+
+	visitor->register_builtin("string_builder_clear", [this, visitor](std::span<RuntimeValue* const> args, RuntimeValue*& result) {
+		get_native_object<NativeStringBuilder>(visitor, args[0])->buffer.clear();
+
+		result = visitor->allocate_value(new RuntimeValue(Type::T_UNDEFINED));
+
+		});
+
+}
@@ -0,0 +1,31 @@
+#ifndef MD_STRINGS_HPP
+#define MD_STRINGS_HPP
+
+#include "module.hpp"
+
+namespace core {
+
+	namespace modules {
+
+		// mutable string buffer, appends are amortized O(1)
+		class NativeStringBuilder : public runtime::GCObject {
+		public:
+			flx_string buffer;
+
+			virtual std::vector<runtime::GCObject*> get_references() override;
+		};
+
+		class ModuleStrings : public Module {
+		public:
+			ModuleStrings();
+			~ModuleStrings();
+
+			void register_functions(analysis::SemanticAnalyser* visitor) override;
+			void register_functions(runtime::Interpreter* visitor) override;
+		};
+
+	}
+
+}
+
+#endif // !MD_STRINGS_HPP
@@ -1,5 +1,36 @@
 #include "module.hpp"
 
+#include "interpreter.hpp"
+#include "constants.hpp"
+
+using namespace core;
 using namespace core::modules;
+using namespace core::runtime;
 
 const std::string Module::INSTANCE_ID_NAME = std::string{ "__instid" };
+
+const std::string Module::NATIVE_OBJECT_NAME = std::string{ "__natobj" };
+
+RuntimeValue* Module::build_native_object(Interpreter* visitor, GCObject* native, const std::string& type_name) {
+	visitor->gc.allocate(native);
+	visitor->gc.add_native_object(native);
+
+	flx_struct str = flx_struct();
+	str[NATIVE_OBJECT_NAME] = visitor->allocate_value(new RuntimeValue(flx_int(native)));
+
+	RuntimeValue* value = visitor->allocate_value(new RuntimeValue(Type::T_STRUCT));
+	value->set(str, type_name, Constants::STD_NAMESPACE);
+
+	return value;
+}
+
+GCObject* Module::find_native_object(Interpreter* visitor, RuntimeValue* value) {
+	if (!TypeUtils::is_struct(value->type)) {
+		throw std::runtime_error("native object is null");
+	}
+	auto native = value->get_native_reference();
+	if (!native || !visitor->gc.is_native_object(native)) {
+		throw std::runtime_error("'" + value->type_name + "' is not a native object");
+	}
+	return native;
+}
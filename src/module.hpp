@@ -2,6 +2,9 @@
 #define MODULE_HPP
 
 #include <string>
+#include <stdexcept>
+
+#include "types.hpp"
 
 namespace core {
 
@@ -18,12 +21,29 @@ namespace core {
 		class Module {
 		public:
 			static const std::string INSTANCE_ID_NAME;
+			// holds a gc managed native object, traced by the collector
+			static const std::string NATIVE_OBJECT_NAME;
 
 		public:
 			virtual ~Module() = default;
 
 			virtual void register_functions(analysis::SemanticAnalyser* visitor) = 0;
 			virtual void register_functions(runtime::Interpreter* visitor) = 0;
+
+		protected:
+			// allocates native object at collector and wraps it in a handle struct
+			static RuntimeValue* build_native_object(runtime::Interpreter* visitor, runtime::GCObject* native, const std::string& type_name);
+			// the handle is only trusted when it names a native object known by the collector
+			static runtime::GCObject* find_native_object(runtime::Interpreter* visitor, RuntimeValue* value);
+
+			template <typename T>
+			static T* get_native_object(runtime::Interpreter* visitor, RuntimeValue* value) {
+				auto native = dynamic_cast<T*>(find_native_object(visitor, value));
+				if (!native) {
+					throw std::runtime_error("'" + value->type_name + "' is not the expected native object");
+				}
+				return native;
+			}
 		};
 
 	}
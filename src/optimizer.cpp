@@ -0,0 +1,661 @@
+#include "optimizer.hpp"
+
+using namespace core;
+using namespace core::analysis;
+
+Optimizer::Optimizer(std::shared_ptr<ASTProgramNode> main_program, const std::map<std::string, std::shared_ptr<ASTProgramNode>>& programs, size_t level)
+	: Visitor(programs, main_program, main_program->name), level(level) {};
+
+void Optimizer::start() {
+	// first pass folds and counts declarations, the second one propagates constants and folds the new literals
+	while (true) {
+		for (const auto& [name, program] : programs) {
+			current_program_stack.push(program);
+			visit(program);
+			current_program_stack.pop();
+		}
+
+		if (level < 2 || propagate) {
+			break;
+		}
+
+		propagate = true;
+	}
+}
+
+void Optimizer::optimize(std::shared_ptr<ASTExprNode>& expr) {
+	if (!expr) {
+		return;
+	}
+
+	replacement_expression = nullptr;
+	expr->accept(this);
+
+	if (replacement_expression) {
+		expr = replacement_expression;
+		replacement_expression = nullptr;
+	}
+}
+
+void Optimizer::optimize(std::shared_ptr<ASTNode>& node) {
+	if (!node) {
+		return;
+	}
+
+	if (auto expr = std::dynamic_pointer_cast<ASTExprNode>(node)) {
+		optimize(expr);
+		node = expr;
+	}
+	else {
+		node->accept(this);
+	}
+}
+
+void Optimizer::optimize(std::vector<Identifier>& identifier_vector) {
+	for (auto& identifier : identifier_vector) {
+		for (auto& access : identifier.access_vector) {
+			optimize(access);
+		}
+	}
+}
+
+void Optimizer::optimize(TypeDefinition& type) {
+	for (auto& dim : type.expr_dim) {
+		optimize(dim);
+	}
+}
+
+void Optimizer::optimize_statements(std::vector<std::shared_ptr<ASTNode>>& statements, bool keep_positions) {
+	for (size_t i = 0; i < statements.size();) {
+		auto& statement = statements[i];
+
+		if (std::dynamic_pointer_cast<ASTExprNode>(statement)) {
+			optimize(statement);
+			++i;
+			continue;
+		}
+
+		replacement_statement = nullptr;
+		remove_statement = false;
+
+		statement->accept(this);
+
+		if (remove_statement) {
+			remove_statement = false;
+
+			// switch cases point to statement positions, so an empty block takes the place of the statement
+			if (keep_positions) {
+				auto block = std::make_shared<ASTBlockNode>(std::vector<std::shared_ptr<ASTNode>>(), statement->row, statement->col);
+				block->declares_symbols = false;
+				statement = block;
+			}
+			else {
+				statements.erase(statements.begin() + i);
+				continue;
+			}
+		}
+		else if (replacement_statement) {
+			statement = replacement_statement;
+			replacement_statement = nullptr;
+		}
+
+		++i;
+	}
+}
+
+void Optimizer::optimize_parameters(const std::vector<TypeDefinition*>& parameters) {
+	for (const auto& parameter : parameters) {
+		if (const auto var = dynamic_cast<VariableDefinition*>(parameter)) {
+			declare(var->identifier);
+			optimize(var->default_value);
+		}
+		else if (const auto unpacked = dynamic_cast<UnpackedVariableDefinition*>(parameter)) {
+			for (const auto& var : unpacked->variables) {
+				declare(var.identifier);
+			}
+		}
+	}
+}
+
+std::shared_ptr<ASTExprNode> Optimizer::inline_call(std::shared_ptr<ASTFunctionCallNode> astnode) {
+	const auto return_node = std::dynamic_pointer_cast<ASTReturnNode>(astnode->inline_block->statements[0]);
+	if (!return_node || !return_node->expr) {
+		return nullptr;
+	}
+
+	// arguments are substituted into the returned expression, so they must be free of side effects
+	std::unordered_map<std::string, std::shared_ptr<ASTExprNode>> arguments;
+	for (size_t i = 0; i < astnode->parameters.size(); ++i) {
+		const auto& arg = astnode->parameters[i];
+		const auto id = std::dynamic_pointer_cast<ASTIdentifierNode>(arg);
+		if (literal_type(arg) == Type::T_UNDEFINED && !(id && id->identifier_vector.size() == 1 && id->identifier_vector[0].access_vector.empty())) {
+			return nullptr;
+		}
+		arguments[astnode->inline_parameters[i]] = arg;
+	}
+
+	return inline_expression(return_node->expr, arguments);
+}
+
+std::shared_ptr<ASTExprNode> Optimizer::inline_expression(const std::shared_ptr<ASTExprNode>& expr,
+	const std::unordered_map<std::string, std::shared_ptr<ASTExprNode>>& arguments) {
+	if (literal_type(expr) != Type::T_UNDEFINED) {
+		return expr;
+	}
+
+	if (const auto id = std::dynamic_pointer_cast<ASTIdentifierNode>(expr)) {
+		const auto& argument = arguments.find(id->identifier);
+		if (argument != arguments.end()) {
+			if (id->identifier_vector.size() != 1 || !id->identifier_vector[0].access_vector.empty()
+				|| (!id->name_space.empty() && id->name_space != current_program_stack.top()->name_space)) {
+				return nullptr;
+			}
+			return argument->second;
+		}
+
+		auto identifier_vector = id->identifier_vector;
+		for (auto& identifier : identifier_vector) {
+			for (auto& access : identifier.access_vector) {
+				access = inline_expression(access, arguments);
+				if (!access) {
+					return nullptr;
+				}
+			}
+		}
+		return std::make_shared<ASTIdentifierNode>(identifier_vector, id->name_space, id->row, id->col);
+	}
+
+	if (const auto binary = std::dynamic_pointer_cast<ASTBinaryExprNode>(expr)) {
+		auto left = inline_expression(binary->left, arguments);
+		auto right = left ? inline_expression(binary->right, arguments) : nullptr;
+		if (!right) {
+			return nullptr;
+		}
+		auto node = std::make_shared<ASTBinaryExprNode>(binary->op, left, right, binary->row, binary->col);
+		node->operand_type = binary->operand_type;
+		return node;
+	}
+
+	if (const auto unary = std::dynamic_pointer_cast<ASTUnaryExprNode>(expr)) {
+		if (unary->unary_op != "-" && unary->unary_op != "~" && unary->unary_op != "not") {
+			return nullptr;
+		}
+		auto value = inline_expression(unary->expr, arguments);
+		return value ? std::make_shared<ASTUnaryExprNode>(unary->unary_op, value, unary->row, unary->col) : nullptr;
+	}
+
+	if (const auto ternary = std::dynamic_pointer_cast<ASTTernaryNode>(expr)) {
+		auto condition = inline_expression(ternary->condition, arguments);
+		auto value_if_true = condition ? inline_expression(ternary->value_if_true, arguments) : nullptr;
+		auto value_if_false = value_if_true ? inline_expression(ternary->value_if_false, arguments) : nullptr;
+		return value_if_false ? std::make_shared<ASTTernaryNode>(condition, value_if_true, value_if_false, ternary->row, ternary->col) : nullptr;
+	}
+
+	if (const auto cast = std::dynamic_pointer_cast<ASTTypeCastNode>(expr)) {
+		auto value = inline_expression(cast->expr, arguments);
+		return value ? std::make_shared<ASTTypeCastNode>(cast->type, value, cast->row, cast->col) : nullptr;
+	}
+
+	return nullptr;
+}
+
+void Optimizer::declare(const std::string& identifier) {
+	if (!propagate) {
+		++declarations[current_program_stack.top()->name_space][identifier];
+	}
+}
+
+std::shared_ptr<ASTExprNode> Optimizer::find_constant(const std::string& identifier) const {
+	for (auto it = constants.rbegin(); it != constants.rend(); ++it) {
+		const auto& constant = it->find(identifier);
+		if (constant != it->end()) {
+			return constant->second;
+		}
+	}
+	return nullptr;
+}
+
+Type Optimizer::literal_type(const std::shared_ptr<ASTExprNode>& expr) {
+	std::unique_ptr<RuntimeValue> value(literal_value(expr));
+	return value ? value->type : Type::T_UNDEFINED;
+}
+
+bool Optimizer::is_bool_literal(const std::shared_ptr<ASTExprNode>& expr, flx_bool& value) {
+	if (const auto literal = std::dynamic_pointer_cast<ASTLiteralNode<flx_bool>>(expr)) {
+		value = literal->value;
+		return true;
+	}
+	return false;
+}
+
+RuntimeValue* Optimizer::literal_value(const std::shared_ptr<ASTExprNode>& expr) {
+	if (const auto literal = std::dynamic_pointer_cast<ASTLiteralNode<flx_bool>>(expr)) {
+		return new RuntimeValue(literal->value);
+	}
+	if (const auto literal = std::dynamic_pointer_cast<ASTLiteralNode<flx_int>>(expr)) {
+		return new RuntimeValue(literal->value);
+	}
+	if (const auto literal = std::dynamic_pointer_cast<ASTLiteralNode<flx_float>>(expr)) {
+		return new RuntimeValue(literal->value);
+	}
+	if (const auto literal = std::dynamic_pointer_cast<ASTLiteralNode<flx_char>>(expr)) {
+		return new RuntimeValue(literal->value);
+	}
+	if (const auto literal = std::dynamic_pointer_cast<ASTLiteralNode<flx_string>>(expr)) {
+		return new RuntimeValue(literal->value);
+	}
+	return nullptr;
+}
+
+std::shared_ptr<ASTExprNode> Optimizer::literal_node(const RuntimeValue* value, size_t row, size_t col) {
+	switch (value->type) {
+	case Type::T_BOOL:
+		return std::make_shared<ASTLiteralNode<flx_bool>>(value->get_b(), row, col);
+	case Type::T_INT:
+		return std::make_shared<ASTLiteralNode<flx_int>>(value->get_i(), row, col);
+	case Type::T_FLOAT:
+		return std::make_shared<ASTLiteralNode<flx_float>>(value->get_f(), row, col);
+	case Type::T_CHAR:
+		return std::make_shared<ASTLiteralNode<flx_char>>(value->get_c(), row, col);
+	case Type::T_STRING:
+		return std::make_shared<ASTLiteralNode<flx_string>>(value->get_s(), row, col);
+	default:
+		return nullptr;
+	}
+}
+
+void Optimizer::visit(std::shared_ptr<ASTProgramNode> astnode) {
+	constants.emplace_back();
+	optimize_statements(astnode->statements, false);
+	constants.pop_back();
+}
+
+void Optimizer::visit(std::shared_ptr<ASTUsingNode>) {}
+void Optimizer::visit(std::shared_ptr<ASTIncludeNamespaceNode>) {}
+void Optimizer::visit(std::shared_ptr<ASTExcludeNamespaceNode>) {}
+
+void Optimizer::visit(std::shared_ptr<ASTDeclarationNode> astnode) {
+	optimize(astnode->expr);
+	optimize(*astnode);
+	declare(astnode->identifier);
+
+	// any typed variables divide integers as floats, so only values of the declared type are propagated
+	if (propagate && astnode->is_const && declarations[current_program_stack.top()->name_space][astnode->identifier] == 1
+		&& astnode->expr && literal_type(astnode->expr) == astnode->type) {
+		constants.back()[astnode->identifier] = astnode->expr;
+	}
+}
+
+void Optimizer::visit(std::shared_ptr<ASTUnpackedDeclarationNode> astnode) {
+	optimize(astnode->expr);
+	for (const auto& declaration : astnode->declarations) {
+		declaration->accept(this);
+	}
+}
+
+void Optimizer::visit(std::shared_ptr<ASTAssignmentNode> astnode) {
+	optimize(astnode->identifier_vector);
+	optimize(astnode->expr);
+}
+
+void Optimizer::visit(std::shared_ptr<ASTFunctionExpressionAssignmentNode> astnode) {
+	astnode->function->accept(this);
+	optimize(astnode->expr);
+}
+
+void Optimizer::visit(std::shared_ptr<ASTReturnNode> astnode) {
+	optimize(astnode->expr);
+
+	// an inlined or folded call is no longer a tail call
+	if (astnode->tail_call && !std::dynamic_pointer_cast<ASTFunctionCallNode>(astnode->expr)) {
+		astnode->tail_call = false;
+	}
+}
+
+void Optimizer::visit(std::shared_ptr<ASTExitNode> astnode) {
+	optimize(astnode->exit_code);
+}
+
+void Optimizer::visit(std::shared_ptr<ASTBlockNode> astnode) {
+	constants.emplace_back();
+	optimize_statements(astnode->statements, false);
+	constants.pop_back();
+}
+
+void Optimizer::visit(std::shared_ptr<ASTContinueNode>) {}
+void Optimizer::visit(std::shared_ptr<ASTBreakNode>) {}
+
+void Optimizer::visit(std::shared_ptr<ASTSwitchNode> astnode) {
+	optimize(astnode->condition);
+
+	constants.emplace_back();
+	optimize_statements(astnode->statements, true);
+	constants.pop_back();
+}
+
+void Optimizer::visit(std::shared_ptr<ASTEnumNode> astnode) {
+	const auto& name_space = current_program_stack.top()->name_space;
+
+	for (size_t i = 0; i < astnode->identifiers.size(); ++i) {
+		declare(astnode->identifiers[i]);
+
+		if (propagate && declarations[name_space][astnode->identifiers[i]] == 1) {
+			constants.back()[astnode->identifiers[i]] = std::make_shared<ASTLiteralNode<flx_int>>(flx_int(i), astnode->row, astnode->col);
+		}
+	}
+}
+
+void Optimizer::visit(std::shared_ptr<ASTTryCatchNode> astnode) {
+	astnode->try_block->accept(this);
+
+	constants.emplace_back();
+	if (astnode->decl) {
+		astnode->decl->accept(this);
+	}
+	astnode->catch_block->accept(this);
+	constants.pop_back();
+}
+
+void Optimizer::visit(std::shared_ptr<ASTThrowNode> astnode) {
+	optimize(astnode->error);
+}
+
+void Optimizer::visit(std::shared_ptr<ASTEllipsisNode>) {}
+
+void Optimizer::visit(std::shared_ptr<ASTElseIfNode> astnode) {
+	optimize(astnode->condition);
+	astnode->block->accept(this);
+}
+
+void Optimizer::visit(std::shared_ptr<ASTIfNode> astnode) {
+	optimize(astnode->condition);
+	astnode->if_block->accept(this);
+
+	// else ifs that are never taken are dropped, and one that is always taken becomes the else
+	for (size_t i = 0; i < astnode->else_ifs.size();) {
+		const auto else_if = astnode->else_ifs[i];
+		optimize(else_if->condition);
+
+		flx_bool value;
+		if (is_bool_literal(else_if->condition, value)) {
+			if (value) {
+				astnode->else_block = else_if->block;
+				astnode->else_ifs.erase(astnode->else_ifs.begin() + i, astnode->else_ifs.end());
+				break;
+			}
+			astnode->else_ifs.erase(astnode->else_ifs.begin() + i);
+			continue;
+		}
+
+		else_if->block->accept(this);
+		++i;
+	}
+
+	if (astnode->else_block) {
+		astnode->else_block->accept(this);
+	}
+
+	flx_bool value;
+	while (is_bool_literal(astnode->condition, value)) {
+		if (value) {
+			replacement_statement = astnode->if_block;
+			return;
+		}
+
+		if (astnode->else_ifs.empty()) {
+			if (astnode->else_block) {
+				replacement_statement = astnode->else_block;
+			}
+			else {
+				remove_statement = true;
+			}
+			return;
+		}
+
+		// the first else if takes the place of the if
+		astnode->condition = astnode->else_ifs.front()->condition;
+		astnode->if_block = astnode->else_ifs.front()->block;
+		astnode->else_ifs.erase(astnode->else_ifs.begin());
+	}
+}
+
+void Optimizer::visit(std::shared_ptr<ASTForNode> astnode) {
+	constants.emplace_back();
+
+	for (auto& expression : astnode->expressions) {
+		optimize(expression);
+	}
+
+	// the counted loop shares the bound with the condition
+	if (astnode->counted) {
+		if (const auto condition = std::dynamic_pointer_cast<ASTBinaryExprNode>(astnode->expressions[1])) {
+			astnode->counted->bound = condition->right;
+		}
+	}
+
+	astnode->block->accept(this);
+
+	constants.pop_back();
+}
+
+void Optimizer::visit(std::shared_ptr<ASTForEachNode> astnode) {
+	constants.emplace_back();
+
+	optimize(astnode->collection);
+	astnode->itdecl->accept(this);
+	astnode->block->accept(this);
+
+	constants.pop_back();
+}
+
+void Optimizer::visit(std::shared_ptr<ASTWhileNode> astnode) {
+	optimize(astnode->condition);
+	astnode->block->accept(this);
+}
+
+void Optimizer::visit(std::shared_ptr<ASTDoWhileNode> astnode) {
+	optimize(astnode->condition);
+	astnode->block->accept(this);
+}
+
+void Optimizer::visit(std::shared_ptr<ASTFunctionDefinitionNode> astnode) {
+	declare(astnode->identifier);
+
+	constants.emplace_back();
+
+	optimize_parameters(astnode->parameters);
+	if (astnode->block) {
+		astnode->block->accept(this);
+	}
+
+	constants.pop_back();
+}
+
+void Optimizer::visit(std::shared_ptr<ASTStructDefinitionNode>) {}
+
+void Optimizer::visit(std::shared_ptr<ASTLiteralNode<flx_bool>>) {}
+void Optimizer::visit(std::shared_ptr<ASTLiteralNode<flx_int>>) {}
+void Optimizer::visit(std::shared_ptr<ASTLiteralNode<flx_float>>) {}
+void Optimizer::visit(std::shared_ptr<ASTLiteralNode<flx_char>>) {}
+void Optimizer::visit(std::shared_ptr<ASTLiteralNode<flx_string>>) {}
+
+void Optimizer::visit(std::shared_ptr<ASTLambdaFunction> astnode) {
+	astnode->fun->accept(this);
+}
+
+void Optimizer::visit(std::shared_ptr<ASTArrayConstructorNode> astnode) {
+	for (auto& value : astnode->values) {
+		optimize(value);
+	}
+}
+
+void Optimizer::visit(std::shared_ptr<ASTStructConstructorNode> astnode) {
+	for (auto& [name, value] : astnode->values) {
+		optimize(value);
+	}
+}
+
+void Optimizer::visit(std::shared_ptr<ASTBinaryExprNode> astnode) {
+	optimize(astnode->left);
+
+	// the right side of a false and is never evaluated
+	flx_bool value;
+	if (astnode->op == "and" && is_bool_literal(astnode->left, value) && !value) {
+		replacement_expression = astnode->left;
+		return;
+	}
+
+	optimize(astnode->right);
+
+	std::unique_ptr<RuntimeValue> l_value(literal_value(astnode->left));
+	std::unique_ptr<RuntimeValue> r_value(literal_value(astnode->right));
+	if (!l_value || !r_value) {
+		return;
+	}
+
+	// operations that fail are kept, so the error is raised at runtime
+	try {
+		RuntimeValue* res_value = RuntimeOperations::do_operation(astnode->op, l_value.get(), r_value.get(), true);
+		std::unique_ptr<RuntimeValue> owned(res_value != l_value.get() && res_value != r_value.get() ? res_value : nullptr);
+		replacement_expression = literal_node(res_value, astnode->row, astnode->col);
+	}
+	catch (const std::exception&) {}
+}
+
+void Optimizer::visit(std::shared_ptr<ASTUnaryExprNode> astnode) {
+	// operators that need the variable itself only have their accesses optimized
+	if (astnode->unary_op == "ref" || astnode->unary_op == "unref"
+		|| astnode->unary_op == "++" || astnode->unary_op == "--") {
+		if (const auto id = std::dynamic_pointer_cast<ASTIdentifierNode>(astnode->expr)) {
+			optimize(id->identifier_vector);
+		}
+		else {
+			optimize(astnode->expr);
+		}
+		return;
+	}
+
+	optimize(astnode->expr);
+
+	std::unique_ptr<RuntimeValue> value(literal_value(astnode->expr));
+	if (!value) {
+		return;
+	}
+
+	if (TypeUtils::is_int(value->type) && astnode->unary_op == "-") {
+		replacement_expression = std::make_shared<ASTLiteralNode<flx_int>>(-value->get_i(), astnode->row, astnode->col);
+	}
+	else if (TypeUtils::is_int(value->type) && astnode->unary_op == "~") {
+		replacement_expression = std::make_shared<ASTLiteralNode<flx_int>>(~value->get_i(), astnode->row, astnode->col);
+	}
+	else if (TypeUtils::is_float(value->type) && astnode->unary_op == "-") {
+		replacement_expression = std::make_shared<ASTLiteralNode<flx_float>>(-value->get_f(), astnode->row, astnode->col);
+	}
+	else if (TypeUtils::is_bool(value->type) && astnode->unary_op == "not") {
+		replacement_expression = std::make_shared<ASTLiteralNode<flx_bool>>(!value->get_b(), astnode->row, astnode->col);
+	}
+}
+
+void Optimizer::visit(std::shared_ptr<ASTIdentifierNode> astnode) {
+	const auto& name_space = current_program_stack.top()->name_space;
+
+	if (propagate && astnode->identifier_vector.size() == 1 && astnode->identifier_vector[0].access_vector.empty()
+		&& (astnode->name_space.empty() || astnode->name_space == name_space)) {
+		if (const auto constant = find_constant(astnode->identifier)) {
+			std::unique_ptr<RuntimeValue> value(literal_value(constant));
+			replacement_expression = literal_node(value.get(), astnode->row, astnode->col);
+			return;
+		}
+	}
+
+	optimize(astnode->identifier_vector);
+}
+
+void Optimizer::visit(std::shared_ptr<ASTTernaryNode> astnode) {
+	optimize(astnode->condition);
+	optimize(astnode->value_if_true);
+	optimize(astnode->value_if_false);
+
+	flx_bool value;
+	if (is_bool_literal(astnode->condition, value)) {
+		replacement_expression = value ? astnode->value_if_true : astnode->value_if_false;
+	}
+}
+
+void Optimizer::visit(std::shared_ptr<ASTInNode> astnode) {
+	optimize(astnode->value);
+	optimize(astnode->collection);
+}
+
+void Optimizer::visit(std::shared_ptr<ASTFunctionCallNode> astnode) {
+	optimize(astnode->identifier_vector);
+	for (auto& parameter : astnode->parameters) {
+		optimize(parameter);
+	}
+	optimize(astnode->expression_identifier_vector);
+	if (astnode->expression_call) {
+		astnode->expression_call->accept(this);
+	}
+
+	if (level >= 2 && astnode->inline_block) {
+		if (auto expr = inline_call(astnode)) {
+			optimize(expr);
+			replacement_expression = expr;
+		}
+	}
+}
+
+void Optimizer::visit(std::shared_ptr<ASTTypeCastNode> astnode) {
+	optimize(astnode->expr);
+}
+
+void Optimizer::visit(std::shared_ptr<ASTTypeNode>) {}
+void Optimizer::visit(std::shared_ptr<ASTNullNode>) {}
+void Optimizer::visit(std::shared_ptr<ASTThisNode>) {}
+
+void Optimizer::visit(std::shared_ptr<ASTTypeOfNode> astnode) {
+	optimize(astnode->expr);
+}
+
+void Optimizer::visit(std::shared_ptr<ASTTypeIdNode> astnode) {
+	optimize(astnode->expr);
+}
+
+void Optimizer::visit(std::shared_ptr<ASTRefIdNode> astnode) {
+	if (const auto id = std::dynamic_pointer_cast<ASTIdentifierNode>(astnode->expr)) {
+		optimize(id->identifier_vector);
+	}
+	else {
+		optimize(astnode->expr);
+	}
+}
+
+void Optimizer::visit(std::shared_ptr<ASTIsStructNode> astnode) {
+	optimize(astnode->expr);
+}
+
+void Optimizer::visit(std::shared_ptr<ASTIsArrayNode> astnode) {
+	optimize(astnode->expr);
+}
+
+void Optimizer::visit(std::shared_ptr<ASTIsAnyNode> astnode) {
+	optimize(astnode->expr);
+}
+
+void Optimizer::visit(std::shared_ptr<ASTValueNode>) {}
+
+intmax_t Optimizer::hash(std::shared_ptr<ASTExprNode>) { return 0; }
+intmax_t Optimizer::hash(std::shared_ptr<ASTValueNode>) { return 0; }
+intmax_t Optimizer::hash(std::shared_ptr<ASTLiteralNode<flx_bool>>) { return 0; }
+intmax_t Optimizer::hash(std::shared_ptr<ASTLiteralNode<flx_int>>) { return 0; }
+intmax_t Optimizer::hash(std::shared_ptr<ASTLiteralNode<flx_float>>) { return 0; }
+intmax_t Optimizer::hash(std::shared_ptr<ASTLiteralNode<flx_char>>) { return 0; }
+intmax_t Optimizer::hash(std::shared_ptr<ASTLiteralNode<flx_string>>) { return 0; }
+intmax_t Optimizer::hash(std::shared_ptr<ASTIdentifierNode>) { return 0; }
+
+void Optimizer::set_curr_pos(size_t row, size_t col) {
+	curr_row = row;
+	curr_col = col;
+}
+
+std::string Optimizer::msg_header() { return ""; }
@@ -0,0 +1,131 @@
+#ifndef OPTIMIZER_HPP
+#define OPTIMIZER_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <memory>
+
+#include "ast.hpp"
+
+namespace core {
+
+	namespace analysis {
+
+		// rewrites the analysed ast before it is interpreted
+		// level 1 folds constant expressions and prunes branches with constant conditions
+		// level 2 also propagates typed const variables and enum values into their use sites,
+		// and inlines calls to functions that only return an expression
+		class Optimizer : public Visitor {
+		private:
+			size_t level;
+			bool propagate = false;
+
+			// replacement of the expression being visited, null when it is kept
+			std::shared_ptr<ASTExprNode> replacement_expression;
+			// replacement of the statement being visited, null when it is kept
+			std::shared_ptr<ASTNode> replacement_statement;
+			bool remove_statement = false;
+
+			// declarations count by namespace, only names declared once are propagated,
+			// so no scope can shadow them, even through function calls
+			std::map<std::string, std::unordered_map<std::string, size_t>> declarations;
+			// literal values of the visible propagated constants, by lexical scope
+			std::vector<std::unordered_map<std::string, std::shared_ptr<ASTExprNode>>> constants;
+
+		public:
+			Optimizer(std::shared_ptr<ASTProgramNode> main_program, const std::map<std::string, std::shared_ptr<ASTProgramNode>>& programs, size_t level);
+
+			void start();
+
+		private:
+			void optimize(std::shared_ptr<ASTExprNode>& expr);
+			void optimize(std::shared_ptr<ASTNode>& node);
+			void optimize(std::vector<Identifier>& identifier_vector);
+			void optimize(TypeDefinition& type);
+			void optimize_statements(std::vector<std::shared_ptr<ASTNode>>& statements, bool keep_positions);
+			void optimize_parameters(const std::vector<TypeDefinition*>& parameters);
+
+			std::shared_ptr<ASTExprNode> inline_call(std::shared_ptr<ASTFunctionCallNode> astnode);
+			std::shared_ptr<ASTExprNode> inline_expression(const std::shared_ptr<ASTExprNode>& expr,
+				const std::unordered_map<std::string, std::shared_ptr<ASTExprNode>>& arguments);
+
+			void declare(const std::string& identifier);
+			std::shared_ptr<ASTExprNode> find_constant(const std::string& identifier) const;
+
+			static Type literal_type(const std::shared_ptr<ASTExprNode>& expr);
+			static bool is_bool_literal(const std::shared_ptr<ASTExprNode>& expr, flx_bool& value);
+			static RuntimeValue* literal_value(const std::shared_ptr<ASTExprNode>& expr);
+			static std::shared_ptr<ASTExprNode> literal_node(const RuntimeValue* value, size_t row, size_t col);
+
+			void visit(std::shared_ptr<ASTProgramNode>) override;
+			void visit(std::shared_ptr<ASTUsingNode>) override;
+			void visit(std::shared_ptr<ASTIncludeNamespaceNode>) override;
+			void visit(std::shared_ptr<ASTExcludeNamespaceNode>) override;
+			void visit(std::shared_ptr<ASTDeclarationNode>) override;
+			void visit(std::shared_ptr<ASTUnpackedDeclarationNode>) override;
+			void visit(std::shared_ptr<ASTAssignmentNode>) override;
+			void visit(std::shared_ptr<ASTFunctionExpressionAssignmentNode>) override;
+			void visit(std::shared_ptr<ASTReturnNode>) override;
+			void visit(std::shared_ptr<ASTExitNode>) override;
+			void visit(std::shared_ptr<ASTBlockNode>) override;
+			void visit(std::shared_ptr<ASTContinueNode>) override;
+			void visit(std::shared_ptr<ASTBreakNode>) override;
+			void visit(std::shared_ptr<ASTSwitchNode>) override;
+			void visit(std::shared_ptr<ASTEnumNode>) override;
+			void visit(std::shared_ptr<ASTTryCatchNode>) override;
+			void visit(std::shared_ptr<ASTThrowNode>) override;
+			void visit(std::shared_ptr<ASTEllipsisNode>) override;
+			void visit(std::shared_ptr<ASTElseIfNode>) override;
+			void visit(std::shared_ptr<ASTIfNode>) override;
+			void visit(std::shared_ptr<ASTForNode>) override;
+			void visit(std::shared_ptr<ASTForEachNode>) override;
+			void visit(std::shared_ptr<ASTWhileNode>) override;
+			void visit(std::shared_ptr<ASTDoWhileNode>) override;
+			void visit(std::shared_ptr<ASTFunctionDefinitionNode>) override;
+			void visit(std::shared_ptr<ASTStructDefinitionNode>) override;
+			void visit(std::shared_ptr<ASTLiteralNode<flx_bool>>) override;
+			void visit(std::shared_ptr<ASTLiteralNode<flx_int>>) override;
+			void visit(std::shared_ptr<ASTLiteralNode<flx_float>>) override;
+			void visit(std::shared_ptr<ASTLiteralNode<flx_char>>) override;
+			void visit(std::shared_ptr<ASTLiteralNode<flx_string>>) override;
+			void visit(std::shared_ptr<ASTLambdaFunction>) override;
+			void visit(std::shared_ptr<ASTArrayConstructorNode>) override;
+			void visit(std::shared_ptr<ASTStructConstructorNode>) override;
+			void visit(std::shared_ptr<ASTBinaryExprNode>) override;
+			void visit(std::shared_ptr<ASTUnaryExprNode>) override;
+			void visit(std::shared_ptr<ASTIdentifierNode>) override;
+			void visit(std::shared_ptr<ASTTernaryNode>) override;
+			void visit(std::shared_ptr<ASTInNode>) override;
+			void visit(std::shared_ptr<ASTFunctionCallNode>) override;
+			void visit(std::shared_ptr<ASTTypeCastNode>) override;
+			void visit(std::shared_ptr<ASTTypeNode>) override;
+			void visit(std::shared_ptr<ASTNullNode>) override;
+			void visit(std::shared_ptr<ASTThisNode>) override;
+			void visit(std::shared_ptr<ASTTypeOfNode>) override;
+			void visit(std::shared_ptr<ASTTypeIdNode>) override;
+			void visit(std::shared_ptr<ASTRefIdNode>) override;
+			void visit(std::shared_ptr<ASTIsStructNode>) override;
+			void visit(std::shared_ptr<ASTIsArrayNode>) override;
+			void visit(std::shared_ptr<ASTIsAnyNode>) override;
+			void visit(std::shared_ptr<ASTValueNode>) override;
+
+			intmax_t hash(std::shared_ptr<ASTExprNode>) override;
+			intmax_t hash(std::shared_ptr<ASTValueNode>) override;
+			intmax_t hash(std::shared_ptr<ASTIdentifierNode>) override;
+			intmax_t hash(std::shared_ptr<ASTLiteralNode<flx_bool>>) override;
+			intmax_t hash(std::shared_ptr<ASTLiteralNode<flx_int>>) override;
+			intmax_t hash(std::shared_ptr<ASTLiteralNode<flx_float>>) override;
+			intmax_t hash(std::shared_ptr<ASTLiteralNode<flx_char>>) override;
+			intmax_t hash(std::shared_ptr<ASTLiteralNode<flx_string>>) override;
+
+			void set_curr_pos(size_t row, size_t col) override;
+			std::string msg_header() override;
+		};
+
+	}
+
+}
+
+#endif // !OPTIMIZER_HPP
@@ -10,173 +10,219 @@ Scope::Scope(std::shared_ptr<ASTProgramNode> owner) : owner(owner) {}
 
 Scope::~Scope() = default;
 
-StructureDefinition Scope::find_declared_structure_definition(const std::string& identifier) {
+const StructureDefinition& Scope::find_declared_structure_definition(const Atom& identifier) {
 	return structure_symbol_table.at(identifier);
 }
 
-std::shared_ptr<Variable> Scope::find_declared_variable(const std::string& identifier) {
+std::shared_ptr<Variable> Scope::find_declared_variable(const Atom& identifier) {
 	auto& var = variable_symbol_table.at(identifier);
 	var->reset_ref();
 	return var;
 }
 
-FunctionDefinition& Scope::find_declared_function(const std::string& identifier, const std::vector<TypeDefinition*>* signature, bool strict) {
-	auto funcs = function_symbol_table.equal_range(identifier);
+FunctionDefinition* Scope::find_declared_function(const Atom& identifier, const std::vector<TypeDefinition*>* signature, bool strict) {
+	auto overloads = function_symbol_table.find(identifier);
+	if (overloads == function_symbol_table.end()) {
+		return nullptr;
+	}
+
+	auto& [definitions, signatures] = overloads->second;
 
-	if (std::distance(funcs.first, funcs.second) == 0) {
-		throw std::runtime_error("definition of '" + identifier + "' function signature not found");
+	// an overload declared with exactly the call types is tried first, a single one is just matched
+	if (signature && definitions.size() > 1) {
+		auto exact = signatures.find(signature_hash(*signature));
+		if (exact != signatures.end() && match_signature(*exact->second, signature, strict)) {
+			return exact->second;
+		}
 	}
 
-	for (auto& it = funcs.first; it != funcs.second; ++it) {
-		if (it->second.is_var || !signature) {
-			return it->second;
+	for (auto& definition : definitions) {
+		if (match_signature(definition, signature, strict)) {
+			return &definition;
 		}
+	}
 
-		auto& func_sig = it->second.parameters;
-		bool rest = false;
-		auto found = true;
-		TypeDefinition* stype = nullptr;
-		TypeDefinition* ftype = nullptr;
-		size_t func_sig_size = func_sig.size();
-		size_t call_sig_size = signature->size();
-
-		// if signatures size match, handle normal cases
-		if (func_sig_size == call_sig_size) {
-			for (size_t i = 0; i < call_sig_size; ++i) {
-				ftype = func_sig.at(i);
-				stype = signature->at(i);
+	return nullptr;
+}
 
-				if (!TypeDefinition::is_any_or_match_type(*ftype, *stype, strict || stype->use_ref)) {
-					found = false;
-					break;
-				}
-			}
+size_t Scope::signature_hash(const std::vector<TypeDefinition*>& signature) {
+	size_t hash = signature.size();
+	for (const auto type : signature) {
+		size_t type_hash = static_cast<size_t>(type->type) * 31 + static_cast<size_t>(type->array_type);
+		if (!type->type_name.empty()) {
+			type_hash ^= std::hash<std::string>()(type->type_name);
+		}
+		hash = hash * 0x9e3779b97f4a7c15 + type_hash;
+	}
+	return hash;
+}
+
+bool Scope::match_signature(const FunctionDefinition& function, const std::vector<TypeDefinition*>* signature, bool strict) {
+	if (function.is_var || !signature) {
+		return true;
+	}
 
-			if (found) {
-				return it->second;
+	auto& func_sig = function.parameters;
+	bool rest = false;
+	auto found = true;
+	TypeDefinition* stype = nullptr;
+	TypeDefinition* ftype = nullptr;
+	// element type the rest values are matched against
+	TypeDefinition rest_type;
+	size_t func_sig_size = func_sig.size();
+	size_t call_sig_size = signature->size();
+
+	// if signatures size match, handle normal cases
+	if (func_sig_size == call_sig_size) {
+		for (size_t i = 0; i < call_sig_size; ++i) {
+			ftype = func_sig.at(i);
+			stype = signature->at(i);
+
+			if (!TypeDefinition::is_any_or_match_type(*ftype, *stype, strict || stype->use_ref)) {
+				found = false;
+				break;
 			}
 		}
 
-		// if function signature is lesser than signature call, handle rest case
-		found = true;
-		if (func_sig_size >= 1 && func_sig_size < call_sig_size) {
-			for (size_t i = 0; i < call_sig_size; ++i) {
-				if (!rest) {
-					ftype = func_sig.at(i);
+		if (found) {
+			return true;
+		}
+	}
 
-					auto parameter = dynamic_cast<VariableDefinition*>(it->second.parameters[i]);
+	// if function signature is lesser than signature call, handle rest case
+	found = true;
+	if (func_sig_size >= 1 && func_sig_size < call_sig_size) {
+		for (size_t i = 0; i < call_sig_size; ++i) {
+			if (!rest) {
+				ftype = func_sig.at(i);
 
-					if (parameter && parameter->is_rest) {
-						rest = true;
-						if (TypeUtils::is_array(ftype->type)) {
-							ftype = new TypeDefinition(ftype->array_type, Type::T_UNDEFINED, std::vector<std::shared_ptr<ASTExprNode>>(), ftype->type_name, ftype->type_name_space);
-						}
-					}
+				auto parameter = dynamic_cast<VariableDefinition*>(function.parameters[i]);
 
-					if (parameter && !parameter->is_rest && i == func_sig.size() - 1) {
-						found = false;
-						break;
+				if (parameter && parameter->is_rest) {
+					rest = true;
+					if (TypeUtils::is_array(ftype->type)) {
+						rest_type = TypeDefinition(ftype->array_type, Type::T_UNDEFINED, std::vector<std::shared_ptr<ASTExprNode>>(), ftype->type_name, ftype->type_name_space);
+						ftype = &rest_type;
 					}
 				}
-				stype = signature->at(i);
 
-				if (!TypeDefinition::is_any_or_match_type(*ftype, *stype, strict || stype->use_ref)) {
+				if (parameter && !parameter->is_rest && i == func_sig.size() - 1) {
 					found = false;
 					break;
 				}
 			}
+			stype = signature->at(i);
 
-			if (found) {
-				return it->second;
+			if (!TypeDefinition::is_any_or_match_type(*ftype, *stype, strict || stype->use_ref)) {
+				found = false;
+				break;
 			}
 		}
 
-		// if function signature is greater than signature call, handle default value cases
-		found = true;
-		if (func_sig_size > call_sig_size) {
-			for (size_t i = 0; i < func_sig_size; ++i) {
-				if (i < call_sig_size) {
-					ftype = func_sig.at(i);
-					stype = signature->at(i);
-
-					if (!TypeDefinition::is_any_or_match_type(*ftype, *stype, strict || stype->use_ref)) {
-						found = false;
-						break;
-					}
-				}
-				else {
-					auto parameter = dynamic_cast<VariableDefinition*>(it->second.parameters[i]);
+		if (found) {
+			return true;
+		}
+	}
 
-					if (parameter && !parameter->default_value) {
-						found = false;
-						break;
-					}
+	// if function signature is greater than signature call, handle default value cases
+	found = true;
+	if (func_sig_size > call_sig_size) {
+		for (size_t i = 0; i < func_sig_size; ++i) {
+			if (i < call_sig_size) {
+				ftype = func_sig.at(i);
+				stype = signature->at(i);
+
+				if (!TypeDefinition::is_any_or_match_type(*ftype, *stype, strict || stype->use_ref)) {
+					found = false;
+					break;
 				}
 			}
+			else {
+				auto parameter = dynamic_cast<VariableDefinition*>(function.parameters[i]);
 
-			// if found and exactly signature size (not rest)
-			if (found) {
-				return it->second;
+				if (parameter && !parameter->default_value) {
+					found = false;
+					break;
+				}
 			}
 		}
+
+		// if found and exactly signature size (not rest)
+		if (found) {
+			return true;
+		}
 	}
 
-	throw std::runtime_error("something went wrong when determining the type of '" + identifier + "' function");
+	return false;
 }
 
-std::pair<std::unordered_multimap<std::string, FunctionDefinition>::iterator,
-	std::unordered_multimap<std::string, FunctionDefinition>::iterator>
-	Scope::find_declared_functions(const std::string& identifier) {
-	auto funcs = function_symbol_table.equal_range(identifier);
-	if (std::distance(funcs.first, funcs.second) == 0) {
-		throw std::runtime_error("definition of '" + identifier + "' function signature not found");
-	}
-	return funcs;
+std::list<FunctionDefinition>* Scope::find_declared_functions(const Atom& identifier) {
+	auto overloads = function_symbol_table.find(identifier);
+	return overloads != function_symbol_table.end() ? &overloads->second.definitions : nullptr;
 }
 
-bool Scope::already_declared_structure_definition(const std::string& identifier) {
+bool Scope::already_declared_structure_definition(const Atom& identifier) {
 	return structure_symbol_table.find(identifier) != structure_symbol_table.end();
 }
 
-bool Scope::already_declared_variable(const std::string& identifier) {
+bool Scope::already_declared_variable(const Atom& identifier) {
 	return variable_symbol_table.find(identifier) != variable_symbol_table.end();
 }
 
-bool Scope::already_declared_function(const std::string& identifier, const std::vector<TypeDefinition*>* signature, bool strict) {
-	try {
-		find_declared_function(identifier, signature, strict);
-		return true;
-	}
-	catch (...) {
-		return false;
+bool Scope::already_declared_function(const Atom& identifier, const std::vector<TypeDefinition*>* signature, bool strict) {
+	return find_declared_function(identifier, signature, strict) != nullptr;
+}
+
+bool Scope::already_declared_function_name(const Atom& identifier) {
+	return function_symbol_table.contains(identifier);
+}
+
+size_t Scope::total_declared_variables() {
+	return variable_symbol_table.size();
+}
+
+size_t Scope::total_declared_symbols() {
+	size_t functions = 0;
+	for (const auto& [identifier, overloads] : function_symbol_table) {
+		functions += overloads.definitions.size();
 	}
+	return structure_symbol_table.size() + functions + variable_symbol_table.size();
 }
 
-bool Scope::already_declared_function_name(const std::string& identifier) {
-	try {
-		find_declared_functions(identifier);
-		return true;
+std::vector<std::string> Scope::declared_names() {
+	std::vector<std::string> names;
+	for (const auto& [identifier, variable] : variable_symbol_table) {
+		names.push_back(identifier);
 	}
-	catch (...) {
-		return false;
+	for (const auto& [identifier, overloads] : function_symbol_table) {
+		names.push_back(identifier);
 	}
+	return names;
 }
 
-
-size_t Scope::total_declared_variables() {
-	return variable_symbol_table.size();
+void Scope::reset(std::shared_ptr<ASTProgramNode> owner, const std::string& name) {
+	structure_symbol_table.clear();
+	function_symbol_table.clear();
+	variable_symbol_table.clear();
+	declared_flexa_struct = false;
+	++generation;
+	this->owner = owner;
+	this->name = name;
 }
 
 void Scope::declare_structure_definition(StructureDefinition structure) {
 	structure_symbol_table[structure.identifier] = structure;
 }
 
-void Scope::declare_variable(const std::string& identifier, const std::shared_ptr<Variable>& variable) {
+void Scope::declare_variable(const Atom& identifier, const std::shared_ptr<Variable>& variable) {
 	variable_symbol_table[identifier] = variable;
 }
 
-void Scope::declare_function(const std::string& identifier, FunctionDefinition function) {
-	function_symbol_table.insert(std::make_pair(identifier, function));
+void Scope::declare_function(const Atom& identifier, FunctionDefinition function) {
+	auto& overloads = function_symbol_table[identifier];
+	auto& definition = overloads.definitions.emplace_back(std::move(function));
+	// the first overload declared with a signature keeps its index entry
+	overloads.signatures.emplace(signature_hash(definition.parameters), &definition);
 }
 
 void Scope::declare_flexa_struct(core::Visitor* visitor) {
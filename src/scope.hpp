@@ -3,46 +3,67 @@
 
 #include <string>
 #include <vector>
+#include <list>
 #include <map>
 #include <unordered_map>
 #include <memory>
 
+#include "atom.hpp"
 #include "types.hpp"
 #include "ast.hpp"
 
 namespace core {
 
+	// overloads of a function name in declaration order, indexed by the hash of their parameter types
+	class FunctionOverloads {
+	public:
+		std::list<FunctionDefinition> definitions;
+		std::unordered_map<size_t, FunctionDefinition*> signatures;
+	};
+
 	class Scope {
 	private:
-		std::unordered_map<std::string, StructureDefinition> structure_symbol_table;
-		std::unordered_multimap<std::string, FunctionDefinition> function_symbol_table;
-		std::unordered_map<std::string, std::shared_ptr<Variable>> variable_symbol_table;
+		std::unordered_map<Atom, StructureDefinition, AtomHash> structure_symbol_table;
+		std::unordered_map<Atom, FunctionOverloads, AtomHash> function_symbol_table;
+		std::unordered_map<Atom, std::shared_ptr<Variable>, AtomHash> variable_symbol_table;
 		bool declared_flexa_struct = false;
 
 	public:
 		std::string name;
 		std::shared_ptr<ASTProgramNode> owner;
+		// incremented on each reset, so references to the previous declarations can be told stale
+		size_t generation = 0;
 
 		Scope(std::shared_ptr<ASTProgramNode> owner, std::string name);
 		Scope(std::shared_ptr<ASTProgramNode> owner);
 		~Scope();
 
-		bool already_declared_structure_definition(const std::string& identifier);
-		bool already_declared_variable(const std::string& identifier);
-		bool already_declared_function(const std::string& identifier, const std::vector<TypeDefinition*>* signature, bool strict = true);
-		bool already_declared_function_name(const std::string& identifier);
+		bool already_declared_structure_definition(const Atom& identifier);
+		bool already_declared_variable(const Atom& identifier);
+		bool already_declared_function(const Atom& identifier, const std::vector<TypeDefinition*>* signature, bool strict = true);
+		bool already_declared_function_name(const Atom& identifier);
 
 		size_t total_declared_variables();
+		size_t total_declared_symbols();
+		// names of the declared variables and functions
+		std::vector<std::string> declared_names();
+
+		// clears all declarations keeping the tables storage, so the scope can be reused
+		void reset(std::shared_ptr<ASTProgramNode> owner, const std::string& name);
 
 		void declare_structure_definition(StructureDefinition structure);
-		void declare_function(const std::string& identifier, FunctionDefinition function);
-		void declare_variable(const std::string& identifier, const std::shared_ptr<Variable>& variable);
-
-		StructureDefinition find_declared_structure_definition(const std::string& identifier);
-		FunctionDefinition& find_declared_function(const std::string& identifier, const std::vector<TypeDefinition*>* signature, bool strict = true);
-		std::pair<std::unordered_multimap<std::string, FunctionDefinition>::iterator,
-			std::unordered_multimap<std::string, FunctionDefinition>::iterator> find_declared_functions(const std::string& identifier);
-		std::shared_ptr<Variable> find_declared_variable(const std::string& identifier);
+		void declare_function(const Atom& identifier, FunctionDefinition function);
+		void declare_variable(const Atom& identifier, const std::shared_ptr<Variable>& variable);
+
+		const StructureDefinition& find_declared_structure_definition(const Atom& identifier);
+		// function lookups return null when nothing matches
+		FunctionDefinition* find_declared_function(const Atom& identifier, const std::vector<TypeDefinition*>* signature, bool strict = true);
+		std::list<FunctionDefinition>* find_declared_functions(const Atom& identifier);
+		std::shared_ptr<Variable> find_declared_variable(const Atom& identifier);
+
+		// checks if a call signature can call the function, with or without strict types
+		static bool match_signature(const FunctionDefinition& function, const std::vector<TypeDefinition*>* signature, bool strict);
+		static size_t signature_hash(const std::vector<TypeDefinition*>& signature);
 
 		void declare_flexa_struct(core::Visitor* visitor);
 
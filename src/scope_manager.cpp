@@ -4,6 +4,32 @@
 
 using namespace core;
 
+void ScopeManager::push_scope(const Atom& name_space, std::shared_ptr<ASTProgramNode> owner, const std::string& name) {
+	if (scope_pool.empty()) {
+		scopes[name_space].push_back(std::make_shared<Scope>(owner, name));
+		return;
+	}
+
+	auto scope = std::move(scope_pool.back());
+	scope_pool.pop_back();
+	scope->owner = owner;
+	scope->name = name;
+	scopes[name_space].push_back(std::move(scope));
+}
+
+void ScopeManager::pop_scope(const Atom& name_space) {
+	auto& name_space_scopes = scopes[name_space];
+	auto scope = std::move(name_space_scopes.back());
+	name_space_scopes.pop_back();
+
+	// scopes still referenced elsewhere keep their declarations
+	if (scope.use_count() == 1 && scope_pool.size() < MAX_POOLED_SCOPES) {
+		// declarations are released now, as if the scope was destroyed
+		scope->reset(nullptr, "");
+		scope_pool.push_back(std::move(scope));
+	}
+}
+
 void ScopeManager::validates_reference_type_assignment(TypeDefinition owner, Value* value) {
 	if (TypeUtils::is_string(owner.type) && TypeUtils::is_char(value->type)
 		&& value->use_ref && value->ref.lock() && !TypeUtils::is_any(value->ref.lock()->type)) {
@@ -15,23 +41,23 @@ void ScopeManager::validates_reference_type_assignment(TypeDefinition owner, Val
 	}
 }
 
-StructureDefinition ScopeManager::find_inner_most_struct(std::shared_ptr<ASTProgramNode> program, const std::string& name_space, const std::string& identifier) {
+const StructureDefinition& ScopeManager::find_inner_most_struct(std::shared_ptr<ASTProgramNode> program, const Atom& name_space, const Atom& identifier) {
 	std::shared_ptr<Scope> scope = get_inner_most_struct_definition_scope(program, name_space, identifier);
 	if (!scope) {
-		throw std::runtime_error("struct '" + identifier + "' not found");
+		throw std::runtime_error("struct '" + identifier.str() + "' not found");
 	}
 	return scope->find_declared_structure_definition(identifier);
 }
 
-std::shared_ptr<Variable> ScopeManager::find_inner_most_variable(std::shared_ptr<ASTProgramNode> program, const std::string& name_space, const std::string& identifier) {
+std::shared_ptr<Variable> ScopeManager::find_inner_most_variable(std::shared_ptr<ASTProgramNode> program, const Atom& name_space, const Atom& identifier) {
 	std::shared_ptr<Scope> scope = get_inner_most_variable_scope(program, name_space, identifier);
 	if (!scope) {
-		throw std::runtime_error("variable '" + identifier + "' not found");
+		throw std::runtime_error("variable '" + identifier.str() + "' not found");
 	}
 	return scope->find_declared_variable(identifier);
 }
 
-std::shared_ptr<Scope> ScopeManager::get_inner_most_variable_scope_aux(const std::string& name_space, const std::string& identifier, std::vector<std::string>& visited) {
+std::shared_ptr<Scope> ScopeManager::get_inner_most_variable_scope_aux(const Atom& name_space, const Atom& identifier, std::vector<Atom>& visited) {
 	if (name_space.empty()) {
 		return nullptr;
 	}
@@ -48,7 +74,7 @@ std::shared_ptr<Scope> ScopeManager::get_inner_most_variable_scope_aux(const std
 	return scopes[name_space][i];
 }
 
-std::shared_ptr<Scope> ScopeManager::get_inner_most_variable_scope(std::shared_ptr<ASTProgramNode> program, const std::string& name_space, const std::string& identifier, std::vector<std::string> vp, std::vector<std::string> vf) {
+std::shared_ptr<Scope> ScopeManager::get_inner_most_variable_scope(std::shared_ptr<ASTProgramNode> program, const Atom& name_space, const Atom& identifier, std::vector<Atom> vp, std::vector<Atom> vf) {
 	if (utils::CollectionUtils::contains(vp, program->name)) {
 		return nullptr;
 	}
@@ -81,7 +107,7 @@ std::shared_ptr<Scope> ScopeManager::get_inner_most_variable_scope(std::shared_p
 	return nullptr;
 }
 
-std::shared_ptr<Scope> ScopeManager::get_inner_most_struct_definition_scope_aux(const std::string& name_space, const std::string& identifier, std::vector<std::string>& visited) {
+std::shared_ptr<Scope> ScopeManager::get_inner_most_struct_definition_scope_aux(const Atom& name_space, const Atom& identifier, std::vector<Atom>& visited) {
 	if (name_space.empty()) {
 		return nullptr;
 	}
@@ -98,7 +124,7 @@ std::shared_ptr<Scope> ScopeManager::get_inner_most_struct_definition_scope_aux(
 	return scopes[name_space][i];
 }
 
-std::shared_ptr<Scope> ScopeManager::get_inner_most_struct_definition_scope(std::shared_ptr<ASTProgramNode> program, const std::string& name_space, const std::string& identifier, std::vector<std::string> vp, std::vector<std::string> vf) {
+std::shared_ptr<Scope> ScopeManager::get_inner_most_struct_definition_scope(std::shared_ptr<ASTProgramNode> program, const Atom& name_space, const Atom& identifier, std::vector<Atom> vp, std::vector<Atom> vf) {
 	if (utils::CollectionUtils::contains(vp, program->name)) {
 		return nullptr;
 	}
@@ -131,7 +157,7 @@ std::shared_ptr<Scope> ScopeManager::get_inner_most_struct_definition_scope(std:
 	return nullptr;
 }
 
-std::shared_ptr<Scope> ScopeManager::get_inner_most_functions_scope_aux(const std::string& name_space, const std::string& identifier, std::vector<std::string>& visited) {
+std::shared_ptr<Scope> ScopeManager::get_inner_most_functions_scope_aux(const Atom& name_space, const Atom& identifier, std::vector<Atom>& visited) {
 	if (name_space.empty()) {
 		return nullptr;
 	}
@@ -148,8 +174,8 @@ std::shared_ptr<Scope> ScopeManager::get_inner_most_functions_scope_aux(const st
 	return scopes[name_space][i];
 }
 
-std::shared_ptr<Scope> ScopeManager::get_inner_most_functions_scope(std::shared_ptr<ASTProgramNode> program, const std::string& name_space, const std::string& identifier,
-	std::vector<std::string> vp, std::vector<std::string> vf) {
+std::shared_ptr<Scope> ScopeManager::get_inner_most_functions_scope(std::shared_ptr<ASTProgramNode> program, const Atom& name_space, const Atom& identifier,
+	std::vector<Atom> vp, std::vector<Atom> vf) {
 	if (utils::CollectionUtils::contains(vp, program->name)) {
 		return nullptr;
 	}
@@ -182,8 +208,8 @@ std::shared_ptr<Scope> ScopeManager::get_inner_most_functions_scope(std::shared_
 	return nullptr;
 }
 
-std::shared_ptr<Scope> ScopeManager::get_inner_most_function_scope_aux(const std::string& name_space, const std::string& identifier,
-	const std::vector<TypeDefinition*>* signature, bool strict, std::vector<std::string>& visited) {
+std::shared_ptr<Scope> ScopeManager::get_inner_most_function_scope_aux(const Atom& name_space, const Atom& identifier,
+	const std::vector<TypeDefinition*>* signature, bool strict, std::vector<Atom>& visited) {
 	if (name_space.empty()) {
 		return nullptr;
 	}
@@ -200,8 +226,8 @@ std::shared_ptr<Scope> ScopeManager::get_inner_most_function_scope_aux(const std
 	return scopes[name_space][i];
 }
 
-std::shared_ptr<Scope> ScopeManager::get_inner_most_function_scope(std::shared_ptr<ASTProgramNode> program, const std::string& name_space, const std::string& identifier,
-	const std::vector<TypeDefinition*>* signature, bool strict, std::vector<std::string> vp, std::vector<std::string> vf) {
+std::shared_ptr<Scope> ScopeManager::get_inner_most_function_scope(std::shared_ptr<ASTProgramNode> program, const Atom& name_space, const Atom& identifier,
+	const std::vector<TypeDefinition*>* signature, bool strict, std::vector<Atom> vp, std::vector<Atom> vf) {
 	if (utils::CollectionUtils::contains(vp, program->name)) {
 		return nullptr;
 	}
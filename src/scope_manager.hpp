@@ -20,35 +20,44 @@ namespace core {
 	class ASTIdentifierNode;
 
 	class ScopeManager {
+	private:
+		static const size_t MAX_POOLED_SCOPES = 64;
+
+		// popped scopes not referenced elsewhere, reused by push_scope
+		std::vector<std::shared_ptr<Scope>> scope_pool;
+
 	public:
-		std::unordered_map<std::string, std::vector<std::shared_ptr<Scope>>> scopes;
-		std::map<std::string, std::vector<std::string>> program_nmspaces;
+		std::unordered_map<Atom, std::vector<std::shared_ptr<Scope>>, AtomHash> scopes;
+		std::unordered_map<Atom, std::vector<Atom>, AtomHash> program_nmspaces;
 
 		ScopeManager() = default;
 		virtual ~ScopeManager() = default;
 
+		void push_scope(const Atom& name_space, std::shared_ptr<ASTProgramNode> owner, const std::string& name = "");
+		void pop_scope(const Atom& name_space);
+
 		void validates_reference_type_assignment(TypeDefinition owner, Value* value);
 
-		StructureDefinition find_inner_most_struct(std::shared_ptr<ASTProgramNode> program, const std::string& name_space, const std::string& identifier);
-		std::shared_ptr<Variable> find_inner_most_variable(std::shared_ptr<ASTProgramNode> program, const std::string& name_space, const std::string& identifier);
+		const StructureDefinition& find_inner_most_struct(std::shared_ptr<ASTProgramNode> program, const Atom& name_space, const Atom& identifier);
+		std::shared_ptr<Variable> find_inner_most_variable(std::shared_ptr<ASTProgramNode> program, const Atom& name_space, const Atom& identifier);
 
-		std::shared_ptr<Scope> get_inner_most_struct_definition_scope_aux(const std::string& name_space, const std::string& identifier, std::vector<std::string>& visited);
-		std::shared_ptr<Scope> get_inner_most_struct_definition_scope(std::shared_ptr<ASTProgramNode> program, const std::string& name_space, const std::string& identifier,
-			std::vector<std::string> vp = std::vector<std::string>(), std::vector<std::string> vf = std::vector<std::string>());
+		std::shared_ptr<Scope> get_inner_most_struct_definition_scope_aux(const Atom& name_space, const Atom& identifier, std::vector<Atom>& visited);
+		std::shared_ptr<Scope> get_inner_most_struct_definition_scope(std::shared_ptr<ASTProgramNode> program, const Atom& name_space, const Atom& identifier,
+			std::vector<Atom> vp = std::vector<Atom>(), std::vector<Atom> vf = std::vector<Atom>());
 
-		std::shared_ptr<Scope> get_inner_most_functions_scope_aux(const std::string& name_space, const std::string& identifier, std::vector<std::string>& visited);
-		std::shared_ptr<Scope> get_inner_most_functions_scope(std::shared_ptr<ASTProgramNode> program, const std::string& name_space, const std::string& identifier,
-			std::vector<std::string> vp = std::vector<std::string>(), std::vector<std::string> vf = std::vector<std::string>());
+		std::shared_ptr<Scope> get_inner_most_functions_scope_aux(const Atom& name_space, const Atom& identifier, std::vector<Atom>& visited);
+		std::shared_ptr<Scope> get_inner_most_functions_scope(std::shared_ptr<ASTProgramNode> program, const Atom& name_space, const Atom& identifier,
+			std::vector<Atom> vp = std::vector<Atom>(), std::vector<Atom> vf = std::vector<Atom>());
 
-		std::shared_ptr<Scope> get_inner_most_variable_scope_aux(const std::string& name_space, const std::string& identifier, std::vector<std::string>& visited);
-		std::shared_ptr<Scope> get_inner_most_variable_scope(std::shared_ptr<ASTProgramNode> program, const std::string& name_space, const std::string& identifier,
-			std::vector<std::string> vp = std::vector<std::string>(), std::vector<std::string> vf = std::vector<std::string>());
+		std::shared_ptr<Scope> get_inner_most_variable_scope_aux(const Atom& name_space, const Atom& identifier, std::vector<Atom>& visited);
+		std::shared_ptr<Scope> get_inner_most_variable_scope(std::shared_ptr<ASTProgramNode> program, const Atom& name_space, const Atom& identifier,
+			std::vector<Atom> vp = std::vector<Atom>(), std::vector<Atom> vf = std::vector<Atom>());
 
-		std::shared_ptr<Scope> get_inner_most_function_scope_aux(const std::string& name_space, const std::string& identifier,
-			const std::vector<TypeDefinition*>* signature, bool strict, std::vector<std::string>& visited);
-		std::shared_ptr<Scope> get_inner_most_function_scope(std::shared_ptr<ASTProgramNode> program, const std::string& name_space, const std::string& identifier,
+		std::shared_ptr<Scope> get_inner_most_function_scope_aux(const Atom& name_space, const Atom& identifier,
+			const std::vector<TypeDefinition*>* signature, bool strict, std::vector<Atom>& visited);
+		std::shared_ptr<Scope> get_inner_most_function_scope(std::shared_ptr<ASTProgramNode> program, const Atom& name_space, const Atom& identifier,
 			const std::vector<TypeDefinition*>* signature, bool strict = true,
-			std::vector<std::string> vp = std::vector<std::string>(), std::vector<std::string> vf = std::vector<std::string>());
+			std::vector<Atom> vp = std::vector<Atom>(), std::vector<Atom> vf = std::vector<Atom>());
 
 	};
 
@@ -28,6 +28,7 @@ SemanticAnalyser::SemanticAnalyser(std::shared_ptr<Scope> global_scope, std::sha
 
 void SemanticAnalyser::start() {
 	visit(current_program_stack.top());
+	resolve_tail_calls();
 }
 
 void SemanticAnalyser::visit(std::shared_ptr<ASTProgramNode> astnode) {
@@ -145,7 +146,7 @@ void SemanticAnalyser::visit(std::shared_ptr<ASTDeclarationNode> astnode) {
 	}
 
 	if (TypeUtils::is_struct(astnode->type)) {
-		auto type_name_space = astnode->type_name_space.empty() ? name_space : astnode->type_name_space;
+		auto type_name_space = astnode->type_name_space.empty() ? name_space.str() : astnode->type_name_space;
 		if (!get_inner_most_struct_definition_scope(current_program, type_name_space, astnode->type_name)) {
 			throw std::runtime_error("struct '" + astnode->type_name + "' not found");
 		}
@@ -239,6 +240,8 @@ void SemanticAnalyser::visit(std::shared_ptr<ASTAssignmentNode> astnode) {
 		throw std::runtime_error("expected assignment operator, but found '" + astnode->op + "'");
 	}
 
+	reference_name(name_space, identifier);
+
 	std::shared_ptr<Scope> curr_scope = get_inner_most_variable_scope(current_program, name_space, identifier);
 	if (!curr_scope) {
 		bool isfunc = false;
@@ -291,6 +294,12 @@ void SemanticAnalyser::visit(std::shared_ptr<ASTAssignmentNode> astnode) {
 		curr_expr = *declared_variable;
 	}
 
+	if (astnode->identifier_vector.size() == 1 && astnode->identifier_vector[0].access_vector.empty()
+		&& declared_variable->type == assignment_expr.type
+		&& (TypeUtils::is_int(declared_variable->type) || TypeUtils::is_float(declared_variable->type) || TypeUtils::is_string(declared_variable->type))) {
+		astnode->value_type = declared_variable->type;
+	}
+
 	assignment_expr = SemanticValue(do_operation(astnode->op, *declared_variable, curr_expr,
 		assignment_expr, false), 0, false, astnode->row, astnode->col);
 
@@ -381,6 +390,17 @@ void SemanticAnalyser::visit(std::shared_ptr<ASTReturnNode> astnode) {
 		if (!TypeDefinition::is_any_or_match_type(currfun, return_expr)) {
 			ExceptionHandler::throw_return_type_err(currfun.identifier, currfun, return_expr);
 		}
+
+		astnode->exact_type = astnode->expr && return_expr.type == currfun.type && return_expr.dim.empty()
+			&& (TypeUtils::is_bool(currfun.type) || TypeUtils::is_int(currfun.type) || TypeUtils::is_float(currfun.type)
+				|| TypeUtils::is_char(currfun.type) || TypeUtils::is_string(currfun.type));
+
+		// calls inside a try block must keep the caller frame, the catch block handles their errors,
+		// the others are confirmed once all name references are known
+		astnode->tail_call = false;
+		if (try_depth == 0 && !function_frames.empty() && is_tail_call(astnode->expr)) {
+			function_frames.back().tail_calls.push_back(astnode);
+		}
 	}
 }
 
@@ -423,6 +443,8 @@ void SemanticAnalyser::visit(std::shared_ptr<ASTFunctionCallNode> astnode) {
 	}
 	// handle regular call
 	else {
+		reference_name(name_space, astnode->identifier);
+
 		std::shared_ptr<Scope> curr_scope = get_inner_most_function_scope(current_program, name_space, astnode->identifier, &signature, strict);
 		if (!curr_scope) {
 			curr_scope = get_inner_most_function_scope(current_program, name_space, astnode->identifier, &signature, strict);
@@ -432,7 +454,27 @@ void SemanticAnalyser::visit(std::shared_ptr<ASTFunctionCallNode> astnode) {
 			}
 		}
 
-		auto& curr_function = curr_scope->find_declared_function(astnode->identifier, &signature, strict);
+		auto& curr_function = *curr_scope->find_declared_function(astnode->identifier, &signature, strict);
+
+		// the overload is fixed here, so the optimizer may inline it when the arguments have exactly its parameter types
+		astnode->inline_block = nullptr;
+		astnode->inline_parameters.clear();
+		if (name_space == current_program->name_space && !astnode->expression_call
+			&& astnode->expression_identifier_vector.size() == 1 && astnode->expression_identifier_vector[0].access_vector.empty()
+			&& is_inline_function(curr_function) && curr_function.parameters.size() == astnode->parameters.size()) {
+			std::vector<std::string> parameters;
+			for (size_t i = 0; i < astnode->parameters.size(); ++i) {
+				const auto param = dynamic_cast<VariableDefinition*>(curr_function.parameters[i]);
+				if (!is_inline_argument(astnode->parameters[i], param->type)) {
+					break;
+				}
+				parameters.push_back(param->identifier);
+			}
+			if (parameters.size() == astnode->parameters.size()) {
+				astnode->inline_block = curr_function.block;
+				astnode->inline_parameters = parameters;
+			}
+		}
 
 		if (TypeUtils::is_void(curr_function.type)) {
 			current_expression = SemanticValue(Type::T_UNDEFINED, 0, 0);
@@ -459,18 +501,14 @@ void SemanticAnalyser::visit(std::shared_ptr<ASTFunctionCallNode> astnode) {
 
 }
 
-void SemanticAnalyser::visit(std::shared_ptr<ASTBuiltinCallNode> astnode) {}
-
 void SemanticAnalyser::visit(std::shared_ptr<ASTFunctionDefinitionNode> astnode) {
 	set_curr_pos(astnode->row, astnode->col);
 	const auto& current_program = current_program_stack.top();
 	const auto& name_space = normalize_name_space(astnode->type_name_space, current_program->name_space);
 
 	for (const auto& scope : scopes[name_space]) {
-		if (scope->already_declared_function(astnode->identifier, &astnode->parameters)) {
-			const auto& decl_function = scope->find_declared_function(astnode->identifier, &astnode->parameters);
-
-			if (!decl_function.block && astnode->block) {
+		if (const auto decl_function = scope->find_declared_function(astnode->identifier, &astnode->parameters)) {
+			if (!decl_function->block && astnode->block) {
 				break;
 			}
 
@@ -484,25 +522,40 @@ void SemanticAnalyser::visit(std::shared_ptr<ASTFunctionDefinitionNode> astnode)
 		auto type = TypeUtils::is_void(astnode->type) && has_return ? Type::T_ANY : astnode->type;
 
 		if (astnode->identifier != "") {
-			try {
-				std::shared_ptr<Scope> func_scope = scopes[name_space].back();
-				auto& declfun = func_scope->find_declared_function(astnode->identifier, &astnode->parameters, true);
-				declfun.type = type;
-				declfun.block = astnode->block;
+			if (auto declfun = scopes[name_space].back()->find_declared_function(astnode->identifier, &astnode->parameters, true)) {
+				declfun->type = type;
+				declfun->block = astnode->block;
 			}
-			catch (...) {
+			else {
 				auto f = FunctionDefinition(astnode->identifier, type, astnode->type_name, astnode->type_name_space,
 					astnode->array_type, astnode->dim, astnode->parameters, astnode->block, astnode->row, astnode->row);
 				scopes[name_space].back()->declare_function(astnode->identifier, f);
 			}
 
-			auto& curr_function = scopes[name_space].back()->find_declared_function(astnode->identifier, &astnode->parameters);
+			auto& curr_function = *scopes[name_space].back()->find_declared_function(astnode->identifier, &astnode->parameters);
 
 			current_function.push(curr_function);
 		}
 
+		// the function body runs outside any try block enclosing its definition
+		auto enclosing_try_depth = try_depth;
+		try_depth = 0;
+		function_frames.push_back(FunctionFrame{ current_program_stack.top()->name_space, scopes[current_program_stack.top()->name_space].size(), {}, {}, {} });
+
 		astnode->block->accept(this);
 
+		for (const auto& tail_call : function_frames.back().tail_calls) {
+			tail_call_candidates.emplace_back(tail_call, function_frames.back().names);
+		}
+		auto captures = std::move(function_frames.back().captures);
+		function_frames.pop_back();
+		// names captured from an enclosing function must also be captured by it
+		captured_names.assign(captures.begin(), captures.end());
+		for (const auto& capture : captured_names) {
+			reference_name(current_program_stack.top()->name_space, capture);
+		}
+		try_depth = enclosing_try_depth;
+
 		if (!TypeUtils::is_void(type)) {
 			if (!has_return) {
 				throw std::runtime_error("defined function '" + astnode->identifier + "' is not guaranteed to return a value");
@@ -533,6 +586,8 @@ void SemanticAnalyser::visit(std::shared_ptr<ASTLambdaFunction> astnode) {
 
 	fun->accept(this);
 
+	astnode->captures = captured_names;
+
 	current_expression = SemanticValue();
 	current_expression.type = Type::T_FUNCTION;
 	current_expression.array_type = fun->array_type;
@@ -550,7 +605,7 @@ void SemanticAnalyser::visit(std::shared_ptr<ASTBlockNode> astnode) {
 
 	scopes[name_space].push_back(std::make_shared<Scope>(current_program));
 
-	auto& curr_scope = scopes[name_space].back();
+	auto curr_scope = scopes[name_space].back();
 
 	if (!current_function.empty()) {
 		for (auto param : current_function.top().parameters) {
@@ -565,10 +620,21 @@ void SemanticAnalyser::visit(std::shared_ptr<ASTBlockNode> astnode) {
 		}
 	}
 
+	// parameters are declared again in the runtime function block, they don't count
+	auto declared_parameters = curr_scope->total_declared_symbols();
+
 	for (const auto& stmt : astnode->statements) {
 		stmt->accept(this);
 	}
 
+	astnode->declares_symbols = curr_scope->total_declared_symbols() > declared_parameters;
+
+	if (!function_frames.empty()) {
+		for (const auto& name : curr_scope->declared_names()) {
+			function_frames.back().names.insert(name);
+		}
+	}
+
 	scopes[name_space].pop_back();
 }
 
@@ -611,7 +677,8 @@ void SemanticAnalyser::visit(std::shared_ptr<ASTSwitchNode> astnode) {
 
 	scopes[name_space].push_back(std::make_shared<Scope>(current_program));
 
-	astnode->parsed_case_blocks = std::map<size_t, size_t>();
+	std::map<intmax_t, size_t> parsed_case_blocks;
+	std::unordered_multimap<intmax_t, std::pair<std::shared_ptr<ASTExprNode>, size_t>> string_case_blocks;
 
 	astnode->condition->accept(this);
 
@@ -647,17 +714,42 @@ void SemanticAnalyser::visit(std::shared_ptr<ASTSwitchNode> astnode) {
 		}
 
 		auto hash = expr.first->hash(this);
-		if (astnode->parsed_case_blocks.contains(hash)) {
+
+		if (TypeUtils::is_string(case_type.type)) {
+			// a shared hash is only a duplicate when both values are unknown or equal
+			auto literal = std::dynamic_pointer_cast<ASTLiteralNode<flx_string>>(expr.first);
+			auto range = string_case_blocks.equal_range(hash);
+			for (auto it = range.first; it != range.second; ++it) {
+				auto other = std::dynamic_pointer_cast<ASTLiteralNode<flx_string>>(it->second.first);
+				if (!literal || !other || literal->value == other->value) {
+					throw std::runtime_error("duplicated case value: '" + std::to_string(hash) + "'");
+				}
+			}
+
+			string_case_blocks.emplace(hash, std::make_pair(expr.first, expr.second));
+			continue;
+		}
+
+		if (parsed_case_blocks.contains(hash)) {
 			throw std::runtime_error("duplicated case value: '" + std::to_string(hash) + "'");
 		}
 
-		astnode->parsed_case_blocks.emplace(hash, expr.second);
+		parsed_case_blocks.emplace(hash, expr.second);
 	}
 
 	if (!TypeDefinition::is_any_or_match_type(cond_type, case_type)) {
 		ExceptionHandler::throw_mismatched_type_err(cond_type, case_type);
 	}
 
+	// the condition type is checked here, only conditions matched through any are checked again at runtime
+	astnode->case_type = case_type;
+	astnode->check_condition_type = (!parsed_case_blocks.empty() || !string_case_blocks.empty())
+		&& !TypeDefinition::match_type(cond_type, case_type);
+	astnode->parsed_case_blocks.build(parsed_case_blocks,
+		TypeUtils::is_int(case_type.type) || TypeUtils::is_char(case_type.type) || TypeUtils::is_bool(case_type.type),
+		astnode->default_block);
+	astnode->parsed_case_blocks.build_strings(string_case_blocks);
+
 	for (auto& stmt : astnode->statements) {
 		stmt->accept(this);
 	}
@@ -717,6 +809,8 @@ void SemanticAnalyser::visit(std::shared_ptr<ASTForNode> astnode) {
 
 	scopes[name_space].push_back(std::make_shared<Scope>(current_program));
 
+	astnode->counted = build_counted_loop(astnode);
+
 	if (astnode->expressions[0]) {
 		astnode->expressions[0]->accept(this);
 	}
@@ -872,7 +966,9 @@ void SemanticAnalyser::visit(std::shared_ptr<ASTTryCatchNode> astnode) {
 	const auto& current_program = current_program_stack.top();
 	const auto& name_space = current_program->name_space;
 
+	++try_depth;
 	astnode->try_block->accept(this);
+	--try_depth;
 
 	scopes[name_space].push_back(std::make_shared<Scope>(current_program));
 
@@ -1067,8 +1163,9 @@ void SemanticAnalyser::visit(std::shared_ptr<ASTArrayConstructorNode> astnode) {
 		++arr_size;
 	}
 
+	// ragged nested arrays can be deeper than the dimensions recorded so far
 	auto current_sim_index = current_expression_array_dim_max - 1;
-	if (current_expression_array_dim[current_sim_index] == -1) {
+	if (static_cast<size_t>(current_sim_index) < current_expression_array_dim.size() && current_expression_array_dim[current_sim_index] == -1) {
 		current_expression_array_dim[current_sim_index] = arr_size;
 	}
 
@@ -1139,6 +1236,8 @@ void SemanticAnalyser::visit(std::shared_ptr<ASTIdentifierNode> astnode) {
 	const auto& current_program = current_program_stack.top();
 	const auto& name_space = normalize_name_space(astnode->name_space, current_program->name_space);
 
+	reference_name(name_space, astnode->identifier);
+
 	std::shared_ptr<Scope> curr_scope = get_inner_most_variable_scope(current_program, name_space, astnode->identifier);
 
 	if (!curr_scope) {
@@ -1200,6 +1299,10 @@ void SemanticAnalyser::visit(std::shared_ptr<ASTBinaryExprNode> astnode) {
 
 	auto rexpr = current_expression;
 
+	if (lexpr.type == rexpr.type && (TypeUtils::is_int(lexpr.type) || TypeUtils::is_float(lexpr.type) || TypeUtils::is_string(lexpr.type))) {
+		astnode->operand_type = lexpr.type;
+	}
+
 	current_expression = SemanticValue(do_operation(astnode->op, lexpr, lexpr, rexpr, true), 0, false, 0, 0);
 	current_expression.is_const = lexpr.is_const && rexpr.is_const;
 }
@@ -1625,9 +1728,16 @@ const std::string& SemanticAnalyser::normalize_name_space(std::string& astnode_n
 	return astnode_name_space;
 }
 
+const Atom& SemanticAnalyser::normalize_name_space(Atom& astnode_name_space, const Atom& name_space) const {
+	if (astnode_name_space.empty()) {
+		astnode_name_space = name_space;
+	}
+	return astnode_name_space;
+}
+
 std::shared_ptr<SemanticValue> SemanticAnalyser::access_value(std::shared_ptr<SemanticValue> value, const std::vector<Identifier>& identifier_vector, size_t i) {
 	const auto& current_program = current_program_stack.top();
-	const auto& name_space = value->type_name_space.empty() ? current_program->name_space : value->type_name_space;
+	const Atom name_space = value->type_name_space.empty() ? current_program->name_space : Atom(value->type_name_space);
 	std::shared_ptr<SemanticValue> next_value = value;
 
 	auto access_vector = evaluate_access_vector(identifier_vector[i].access_vector);
@@ -1672,6 +1782,8 @@ std::shared_ptr<SemanticValue> SemanticAnalyser::access_value(std::shared_ptr<Se
 				ExceptionHandler::throw_struct_member_err(next_value->type_name_space, next_value->type_name, identifier_vector[i].identifier);
 			}
 
+			identifier_vector[i].slot = type_struct.shape->index_of(identifier_vector[i].identifier);
+
 			next_value = std::make_shared<SemanticValue>(type_struct.variables[identifier_vector[i].identifier], 0, false, next_value->row, next_value->col);
 		}
 
@@ -1813,12 +1925,152 @@ bool SemanticAnalyser::returns(std::shared_ptr<ASTNode> astnode) {
 	return false;
 }
 
-void SemanticAnalyser::build_args(const std::vector<std::string>& args) {
+void SemanticAnalyser::build_args(const std::vector<std::string>&) {
 	auto flx = std::make_shared<SemanticVariable>("flx", Type::T_STRUCT, Type::T_UNDEFINED, std::vector<size_t>(), "Flexa", Constants::DEFAULT_NAMESPACE, true, 0, 0);
 	flx->set_value(std::make_shared<SemanticValue>(Type::T_STRUCT, Type::T_UNDEFINED, std::vector<size_t>(), "Flexa", Constants::DEFAULT_NAMESPACE, 0, true, 0, 0));
 	scopes[Constants::DEFAULT_NAMESPACE].back()->declare_variable("flx", flx);
 }
 
+std::shared_ptr<CountedLoop> SemanticAnalyser::build_counted_loop(std::shared_ptr<ASTForNode> astnode) {
+	auto is_counter = [](std::shared_ptr<ASTNode> node, const Atom& counter) {
+		auto id = std::dynamic_pointer_cast<ASTIdentifierNode>(node);
+		return id && id->name_space.empty() && id->identifier_vector.size() == 1
+			&& id->identifier_vector[0].access_vector.empty() && id->identifier == counter;
+	};
+
+	// the counter must be declared by the loop, so it is not visible after it
+	auto decl = std::dynamic_pointer_cast<ASTDeclarationNode>(astnode->expressions[0]);
+	if (!decl || decl->is_const || !decl->expr || !decl->expr_dim.empty()
+		|| (!TypeUtils::is_int(decl->type) && !TypeUtils::is_any(decl->type) && !TypeUtils::is_undefined(decl->type))) {
+		return nullptr;
+	}
+
+	auto condition = std::dynamic_pointer_cast<ASTBinaryExprNode>(astnode->expressions[1]);
+	if (!condition || (condition->op != "<" && condition->op != "<=" && condition->op != ">" && condition->op != ">=")
+		|| !is_counter(condition->left, decl->identifier)) {
+		return nullptr;
+	}
+
+	flx_int step = 0;
+	if (auto unary = std::dynamic_pointer_cast<ASTUnaryExprNode>(astnode->expressions[2])) {
+		if (is_counter(unary->expr, decl->identifier)) {
+			step = unary->unary_op == "++" ? 1 : unary->unary_op == "--" ? -1 : 0;
+		}
+	}
+	else if (auto assignment = std::dynamic_pointer_cast<ASTAssignmentNode>(astnode->expressions[2])) {
+		auto literal = std::dynamic_pointer_cast<ASTLiteralNode<flx_int>>(assignment->expr);
+		if (literal && assignment->name_space.empty() && assignment->identifier_vector.size() == 1
+			&& assignment->identifier_vector[0].access_vector.empty() && assignment->identifier == decl->identifier) {
+			step = assignment->op == "+=" ? literal->value : assignment->op == "-=" ? -literal->value : 0;
+		}
+	}
+
+	if (step == 0) {
+		return nullptr;
+	}
+
+	auto counted = std::make_shared<CountedLoop>();
+	counted->counter = decl->identifier;
+	counted->op = condition->op;
+	counted->bound = condition->right;
+	counted->step = step;
+	return counted;
+}
+
+bool SemanticAnalyser::is_inline_function(const FunctionDefinition& function) {
+	if (!function.block || function.block->statements.size() != 1) {
+		return false;
+	}
+
+	const auto return_node = std::dynamic_pointer_cast<ASTReturnNode>(function.block->statements[0]);
+	if (!return_node || !return_node->exact_type) {
+		return false;
+	}
+
+	// reference, rest and any parameters change the arguments, so they can't be substituted
+	for (const auto& param : function.parameters) {
+		const auto var = dynamic_cast<VariableDefinition*>(param);
+		if (!var || var->is_rest || var->use_ref || !var->expr_dim.empty() || !var->dim.empty()
+			|| !(TypeUtils::is_bool(var->type) || TypeUtils::is_int(var->type) || TypeUtils::is_float(var->type)
+				|| TypeUtils::is_char(var->type) || TypeUtils::is_string(var->type))) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool SemanticAnalyser::is_inline_argument(std::shared_ptr<ASTExprNode> arg, Type type) {
+	if (const auto id = std::dynamic_pointer_cast<ASTIdentifierNode>(arg)) {
+		if (id->identifier_vector.size() != 1 || !id->identifier_vector[0].access_vector.empty()) {
+			return false;
+		}
+		const auto& current_program = current_program_stack.top();
+		auto scope = get_inner_most_variable_scope(current_program, normalize_name_space(id->name_space, current_program->name_space), id->identifier);
+		return scope && scope->find_declared_variable(id->identifier)->type == type;
+	}
+
+	if (const auto unary = std::dynamic_pointer_cast<ASTUnaryExprNode>(arg)) {
+		return unary->unary_op == "-" && (TypeUtils::is_int(type) || TypeUtils::is_float(type))
+			&& !std::dynamic_pointer_cast<ASTIdentifierNode>(unary->expr) && is_inline_argument(unary->expr, type);
+	}
+
+	return (TypeUtils::is_bool(type) && std::dynamic_pointer_cast<ASTLiteralNode<flx_bool>>(arg))
+		|| (TypeUtils::is_int(type) && std::dynamic_pointer_cast<ASTLiteralNode<flx_int>>(arg))
+		|| (TypeUtils::is_float(type) && std::dynamic_pointer_cast<ASTLiteralNode<flx_float>>(arg))
+		|| (TypeUtils::is_char(type) && std::dynamic_pointer_cast<ASTLiteralNode<flx_char>>(arg))
+		|| (TypeUtils::is_string(type) && std::dynamic_pointer_cast<ASTLiteralNode<flx_string>>(arg));
+}
+
+bool SemanticAnalyser::is_tail_call(std::shared_ptr<ASTExprNode> expr) {
+	const auto call = std::dynamic_pointer_cast<ASTFunctionCallNode>(expr);
+	if (!call || call->identifier.empty() || call->expression_call
+		|| call->identifier_vector.size() != 1 || !call->identifier_vector[0].access_vector.empty()) {
+		return false;
+	}
+
+	// the returned value must be the call result itself, with no access applied to it
+	const auto& expression_identifier_vector = call->expression_identifier_vector;
+	return expression_identifier_vector.empty() || (expression_identifier_vector.size() == 1
+		&& expression_identifier_vector[0].identifier.empty() && expression_identifier_vector[0].access_vector.empty());
+}
+
+void SemanticAnalyser::reference_name(const std::string& name_space, const std::string& identifier) {
+	if (function_frames.empty()) {
+		return;
+	}
+
+	auto& frame = function_frames.back();
+	if (name_space == frame.name_space) {
+		const auto& frame_scopes = scopes[name_space];
+		for (size_t i = frame_scopes.size(); i > frame.scope_depth; --i) {
+			if (frame_scopes[i - 1]->already_declared_variable(identifier) || frame_scopes[i - 1]->already_declared_function_name(identifier)) {
+				return;
+			}
+		}
+		for (size_t i = frame.scope_depth; i > 1; --i) {
+			if (frame_scopes[i - 1]->already_declared_variable(identifier) || frame_scopes[i - 1]->already_declared_function_name(identifier)) {
+				frame.captures.insert(identifier);
+				break;
+			}
+		}
+	}
+
+	free_names.insert(identifier);
+}
+
+void SemanticAnalyser::resolve_tail_calls() {
+	for (const auto& [tail_call, names] : tail_call_candidates) {
+		tail_call->tail_call = true;
+		for (const auto& name : names) {
+			if (free_names.find(name) != free_names.end()) {
+				tail_call->tail_call = false;
+				break;
+			}
+		}
+	}
+}
+
 bool SemanticAnalyser::is_return_node(std::shared_ptr<ASTNode> astnode) {
 	return std::dynamic_pointer_cast<ASTReturnNode>(astnode)
 		|| std::dynamic_pointer_cast<ASTThrowNode>(astnode);
@@ -1838,7 +2090,7 @@ intmax_t SemanticAnalyser::hash(std::shared_ptr<ASTLiteralNode<flx_int>> astnode
 }
 
 intmax_t SemanticAnalyser::hash(std::shared_ptr<ASTLiteralNode<flx_float>> astnode) {
-	return static_cast<intmax_t>(astnode->value);
+	return hash_float(astnode->value);
 }
 
 intmax_t SemanticAnalyser::hash(std::shared_ptr<ASTLiteralNode<flx_char>> astnode) {
@@ -1846,7 +2098,7 @@ intmax_t SemanticAnalyser::hash(std::shared_ptr<ASTLiteralNode<flx_char>> astnod
 }
 
 intmax_t SemanticAnalyser::hash(std::shared_ptr<ASTLiteralNode<flx_string>> astnode) {
-	return utils::StringUtils::hashcode(astnode->value);
+	return hash_string(astnode->value);
 }
 
 intmax_t SemanticAnalyser::hash(std::shared_ptr<ASTIdentifierNode> astnode) {
@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <stack>
+#include <unordered_set>
 #include <map>
 #include <functional>
 #include <memory>
@@ -28,6 +29,23 @@ namespace core {
 			bool exception = false;
 			bool is_switch = false;
 			bool is_loop = false;
+			size_t try_depth = 0;
+
+			// variables are resolved through the call stack, so a tail call can only drop the frame
+			// of its function when no function resolves one of the frame names outside its own frame
+			struct FunctionFrame {
+				std::string name_space;
+				size_t scope_depth;
+				std::unordered_set<std::string> names;
+				std::vector<std::shared_ptr<ASTReturnNode>> tail_calls;
+				// names resolved in the enclosing blocks, below the frame and above the global scope
+				std::unordered_set<std::string> captures;
+			};
+			std::vector<FunctionFrame> function_frames;
+			std::unordered_set<std::string> free_names;
+			// captures of the last analysed function body, kept by the lambda that owns it
+			std::vector<std::string> captured_names;
+			std::vector<std::pair<std::shared_ptr<ASTReturnNode>, std::unordered_set<std::string>>> tail_call_candidates;
 
 			std::vector<size_t> current_expression_array_dim;
 			int current_expression_array_dim_max;
@@ -35,6 +53,12 @@ namespace core {
 			bool is_max;
 
 		private:
+			std::shared_ptr<CountedLoop> build_counted_loop(std::shared_ptr<ASTForNode> astnode);
+			bool is_inline_function(const FunctionDefinition& function);
+			bool is_inline_argument(std::shared_ptr<ASTExprNode> arg, Type type);
+			bool is_tail_call(std::shared_ptr<ASTExprNode> expr);
+			void reference_name(const std::string& name_space, const std::string& identifier);
+			void resolve_tail_calls();
 			bool is_return_node(std::shared_ptr<ASTNode> astnode);
 			bool returns(std::shared_ptr<ASTNode> astnode);
 
@@ -51,6 +75,7 @@ namespace core {
 			void check_is_struct_exists(Type type, const std::string& name_space, const std::string& identifier);
 
 			const std::string& normalize_name_space(std::string& astnode_name_space, const std::string& name_space) const;
+			const Atom& normalize_name_space(Atom& astnode_name_space, const Atom& name_space) const;
 			bool namespace_exists(const std::string& name_space);
 			void validate_namespace(const std::string& name_space) const;
 
@@ -115,7 +140,6 @@ namespace core {
 			void visit(std::shared_ptr<ASTIsArrayNode>) override;
 			void visit(std::shared_ptr<ASTIsAnyNode>) override;
 			void visit(std::shared_ptr<ASTValueNode>) override;
-			void visit(std::shared_ptr<ASTBuiltinCallNode>) override;
 
 			intmax_t hash(std::shared_ptr<ASTExprNode>) override;
 			intmax_t hash(std::shared_ptr<ASTValueNode>) override;
@@ -1,6 +1,7 @@
 #include "types.hpp"
 
 #include <cmath>
+#include <unordered_set>
 
 #include "utils.hpp"
 #include "exception_handler.hpp"
@@ -10,6 +11,7 @@
 #include "md_files.hpp"
 #include "md_console.hpp"
 #include "visitor.hpp"
+#include "scope.hpp"
 #include "token.hpp"
 #include "constants.hpp"
 
@@ -108,6 +110,117 @@ bool TypeUtils::is_iterable(Type type) {
 	return TypeUtils::is_collection(type) || TypeUtils::is_struct(type);
 }
 
+const StructShape* StructShape::get_root() {
+	static const StructShape root;
+	return &root;
+}
+
+const StructShape* StructShape::add(const std::string& name) const {
+	auto it = indexes.find(name);
+	if (it != indexes.end()) {
+		return this;
+	}
+
+	auto& next = transitions[name];
+	if (!next) {
+		next = std::make_unique<StructShape>();
+		next->names = names;
+		next->names.push_back(name);
+		next->indexes = indexes;
+		next->indexes.emplace(name, names.size());
+	}
+	return next.get();
+}
+
+size_t StructShape::index_of(const std::string& name) const {
+	auto it = indexes.find(name);
+	if (it == indexes.end()) {
+		return npos;
+	}
+	return it->second;
+}
+
+size_t StructShape::size() const {
+	return names.size();
+}
+
+const std::string& StructShape::name_at(size_t index) const {
+	return names[index];
+}
+
+flx_struct::flx_struct()
+	: _shape(StructShape::get_root()) {}
+
+flx_struct::flx_struct(const StructShape* shape)
+	: _shape(shape), _slots(shape->size(), nullptr) {}
+
+const StructShape* flx_struct::shape() const {
+	return _shape;
+}
+
+size_t flx_struct::size() const {
+	return _slots.size();
+}
+
+bool flx_struct::contains(const std::string& identifier) const {
+	return _shape->index_of(identifier) != StructShape::npos;
+}
+
+size_t flx_struct::index_of(const std::string& identifier, size_t hint) const {
+	if (hint < _slots.size() && _shape->name_at(hint) == identifier) {
+		return hint;
+	}
+	return _shape->index_of(identifier);
+}
+
+RuntimeValue*& flx_struct::slot(size_t index) {
+	return _slots[index];
+}
+
+RuntimeValue* flx_struct::slot(size_t index) const {
+	return _slots[index];
+}
+
+RuntimeValue*& flx_struct::operator[](const std::string& identifier) {
+	size_t index = _shape->index_of(identifier);
+	if (index == StructShape::npos) {
+		_shape = _shape->add(identifier);
+		index = _slots.size();
+		_slots.push_back(nullptr);
+	}
+	return _slots[index];
+}
+
+RuntimeValue* flx_struct::at(const std::string& identifier) const {
+	size_t index = _shape->index_of(identifier);
+	if (index == StructShape::npos) {
+		throw std::out_of_range("struct has no member '" + identifier + "'");
+	}
+	return _slots[index];
+}
+
+flx_struct::const_iterator flx_struct::begin() const {
+	return const_iterator(this, 0);
+}
+
+flx_struct::const_iterator flx_struct::end() const {
+	return const_iterator(this, _slots.size());
+}
+
+flx_function::flx_function(const std::string& name_space, const std::string& identifier)
+	: first(name_space), second(identifier) {
+}
+
+flx_function::flx_function(const std::string& name_space, const std::string& identifier, std::shared_ptr<Scope> scope, FunctionDefinition* handle)
+	: first(name_space), second(identifier), scope(scope), generation(scope->generation), handle(handle) {
+}
+
+flx_function::flx_function(const std::string& name_space, std::shared_ptr<FunctionDefinition> definition, std::shared_ptr<ASTProgramNode> program)
+	: first(name_space), second(definition->identifier), definition(definition), program(program), handle(definition.get()) {
+}
+
+flx_function::flx_function() {}
+
 flx_array::flx_array()
 	: _size(0), _data(nullptr) {
 }
@@ -162,7 +275,7 @@ TypeDefinition TypeDefinition::get_struct(const std::string& type_name, const st
 	return TypeDefinition(Type::T_STRUCT, Type::T_UNDEFINED, std::vector<size_t>(), type_name, type_name_space);
 }
 
-bool TypeDefinition::is_any_or_match_type(TypeDefinition ltype, TypeDefinition rtype, bool strict, bool strict_array) {
+bool TypeDefinition::is_any_or_match_type(const TypeDefinition& ltype, const TypeDefinition& rtype, bool strict, bool strict_array) {
 	if (TypeUtils::is_any(ltype.type)
 		|| TypeUtils::is_any(rtype.type)
 		|| TypeUtils::is_void(ltype.type)
@@ -170,7 +283,7 @@ bool TypeDefinition::is_any_or_match_type(TypeDefinition ltype, TypeDefinition r
 	return match_type(ltype, rtype, strict, strict_array);
 }
 
-bool TypeDefinition::match_type(TypeDefinition ltype, TypeDefinition rtype, bool strict, bool strict_array) {
+bool TypeDefinition::match_type(const TypeDefinition& ltype, const TypeDefinition& rtype, bool strict, bool strict_array) {
 	if (match_type_bool(ltype, rtype)) return true;
 	if (match_type_int(ltype, rtype)) return true;
 	if (match_type_float(ltype, rtype, strict)) return true;
@@ -182,31 +295,31 @@ bool TypeDefinition::match_type(TypeDefinition ltype, TypeDefinition rtype, bool
 	return false;
 }
 
-bool TypeDefinition::match_type_bool(TypeDefinition ltype, TypeDefinition rtype) {
+bool TypeDefinition::match_type_bool(const TypeDefinition& ltype, const TypeDefinition& rtype) {
 	return TypeUtils::is_bool(ltype.type) && TypeUtils::is_bool(rtype.type);
 }
 
-bool TypeDefinition::match_type_int(TypeDefinition ltype, TypeDefinition rtype) {
+bool TypeDefinition::match_type_int(const TypeDefinition& ltype, const TypeDefinition& rtype) {
 	return TypeUtils::is_int(ltype.type) && TypeUtils::is_int(rtype.type);
 }
 
-bool TypeDefinition::match_type_float(TypeDefinition ltype, TypeDefinition rtype, bool strict) {
+bool TypeDefinition::match_type_float(const TypeDefinition& ltype, const TypeDefinition& rtype, bool strict) {
 	return TypeUtils::is_float(ltype.type)
 		&& (strict && TypeUtils::is_float(rtype.type) ||
 			!strict && TypeUtils::is_numeric(rtype.type));
 }
 
-bool TypeDefinition::match_type_char(TypeDefinition ltype, TypeDefinition rtype) {
+bool TypeDefinition::match_type_char(const TypeDefinition& ltype, const TypeDefinition& rtype) {
 	return TypeUtils::is_char(ltype.type) && TypeUtils::is_char(rtype.type);
 }
 
-bool TypeDefinition::match_type_string(TypeDefinition ltype, TypeDefinition rtype, bool strict) {
+bool TypeDefinition::match_type_string(const TypeDefinition& ltype, const TypeDefinition& rtype, bool strict) {
 	return TypeUtils::is_string(ltype.type)
 		&& (strict && TypeUtils::is_string(rtype.type) ||
 			!strict && TypeUtils::is_textual(rtype.type));
 }
 
-bool TypeDefinition::match_type_array(TypeDefinition ltype, TypeDefinition rtype, bool strict, bool strict_array) {
+bool TypeDefinition::match_type_array(const TypeDefinition& ltype, const TypeDefinition& rtype, bool strict, bool strict_array) {
 	if (TypeUtils::is_any(ltype.type)
 		|| TypeUtils::is_any(rtype.type)
 		|| TypeUtils::is_void(ltype.type)
@@ -223,18 +336,18 @@ bool TypeDefinition::match_type_array(TypeDefinition ltype, TypeDefinition rtype
 		&& match_array_dim(ltype, rtype);
 }
 
-bool TypeDefinition::match_type_struct(TypeDefinition ltype, TypeDefinition rtype) {
+bool TypeDefinition::match_type_struct(const TypeDefinition& ltype, const TypeDefinition& rtype) {
 	return TypeUtils::is_struct(ltype.type) && TypeUtils::is_struct(rtype.type)
 		&& ltype.type_name == rtype.type_name;
 }
 
-bool TypeDefinition::match_type_function(TypeDefinition ltype, TypeDefinition rtype) {
+bool TypeDefinition::match_type_function(const TypeDefinition& ltype, const TypeDefinition& rtype) {
 	return TypeUtils::is_function(ltype.type) && TypeUtils::is_function(rtype.type);
 }
 
-bool TypeDefinition::match_array_dim(TypeDefinition ltype, TypeDefinition rtype) {
-	std::vector<size_t> var_dim = ltype.dim;
-	std::vector<size_t> expr_dim = rtype.dim;
+bool TypeDefinition::match_array_dim(const TypeDefinition& ltype, const TypeDefinition& rtype) {
+	const auto& var_dim = ltype.dim;
+	const auto& expr_dim = rtype.dim;
 
 	if ((var_dim.size() == 1 && var_dim[0] >= 0 && var_dim[0] <= 1) || (expr_dim.size() == 1 && expr_dim[0] >= 0 && expr_dim[0] <= 1)
 		|| var_dim.size() == 0 || expr_dim.size() == 0) {
@@ -392,17 +505,33 @@ void FunctionDefinition::check_signature() const {
 	}
 }
 
+size_t StructureDefinition::next_id() {
+	static size_t id = 0;
+	return ++id;
+}
+
 StructureDefinition::StructureDefinition(const std::string& identifier, const std::map<std::string, VariableDefinition>& variables,
 	size_t row, size_t col)
-	: CodePosition(row, col), identifier(identifier), variables(variables) {
+	: CodePosition(row, col), identifier(identifier), variables(variables), shape(StructShape::get_root()), id(next_id()) {
+	// members are laid out in declaration order
+	std::vector<const VariableDefinition*> ordered;
+	for (const auto& var : variables) {
+		ordered.push_back(&var.second);
+	}
+	std::stable_sort(ordered.begin(), ordered.end(), [](const VariableDefinition* l, const VariableDefinition* r) {
+		return l->row < r->row || (l->row == r->row && l->col < r->col);
+		});
+	for (const auto& var : ordered) {
+		shape = shape->add(var->identifier);
+	}
 }
 
 StructureDefinition::StructureDefinition(const std::string& identifier)
-	: CodePosition(), identifier(identifier) {
+	: CodePosition(), identifier(identifier), shape(StructShape::get_root()), id(next_id()) {
 }
 
 StructureDefinition::StructureDefinition()
-	: CodePosition(row, col), identifier(""), variables(std::map<std::string, VariableDefinition>()) {
+	: CodePosition(row, col), identifier(""), variables(std::map<std::string, VariableDefinition>()), shape(StructShape::get_root()), id(next_id()) {
 }
 
 Variable::Variable(const std::string& identifier, Type type, Type array_type, const std::vector<size_t>& dim,
@@ -601,8 +730,8 @@ RuntimeValue::RuntimeValue(TypeDefinition v)
 
 RuntimeValue::~RuntimeValue() {
 	if (str) {
-		for (auto& var : *str) {
-			if (var.first == modules::Module::INSTANCE_ID_NAME) {
+		for (const auto& var : *str) {
+			if (var.first == modules::Module::INSTANCE_ID_NAME && var.second) {
 				delete reinterpret_cast<void*>(*var.second->i);
 			}
 		}
@@ -640,7 +769,7 @@ void RuntimeValue::set(flx_char c) {
 
 void RuntimeValue::set(flx_string s) {
 	unset();
-	this->s = new flx_string(s);
+	this->s = std::make_shared<flx_string>(std::move(s));
 	type = Type::T_STRING;
 	array_type = Type::T_UNDEFINED;
 }
@@ -677,11 +806,17 @@ void RuntimeValue::set(flx_function fun) {
 	array_type = Type::T_UNDEFINED;
 }
 
-void RuntimeValue::set_sub(std::string identifier, RuntimeValue* sub_value) {
+void RuntimeValue::set_sub(const std::string& identifier, RuntimeValue* sub_value, size_t slot) {
 	if (!str) return;
 	sub_value->value_ref = this;
 	sub_value->access_identifier = identifier;
-	(*str)[identifier] = sub_value;
+	size_t index = str->index_of(identifier, slot);
+	if (index == StructShape::npos) {
+		(*str)[identifier] = sub_value;
+	}
+	else {
+		str->slot(index) = sub_value;
+	}
 }
 
 void RuntimeValue::set_sub(size_t index, RuntimeValue* sub_value) {
@@ -711,29 +846,40 @@ flx_char RuntimeValue::get_c() const {
 	return *c;
 }
 
-flx_string RuntimeValue::get_s() const {
-	if (!s) return flx_string();
+const flx_string& RuntimeValue::get_s() const {
+	static const flx_string empty;
+	if (!s) return empty;
+	return *s;
+}
+
+std::string_view RuntimeValue::get_sv() const {
+	if (!s) return std::string_view();
 	return *s;
 }
 
-flx_array RuntimeValue::get_arr() const {
-	if (!arr) return flx_array();
+const flx_array& RuntimeValue::get_arr() const {
+	static const flx_array empty;
+	if (!arr) return empty;
 	return *arr;
 }
 
-flx_struct RuntimeValue::get_str() const {
-	if (!str) return flx_struct();
+const flx_struct& RuntimeValue::get_str() const {
+	static const flx_struct empty;
+	if (!str) return empty;
 	return *str;
 }
 
-flx_function RuntimeValue::get_fun() const {
-	if (!fun) return flx_function();
+const flx_function& RuntimeValue::get_fun() const {
+	static const flx_function empty;
+	if (!fun) return empty;
 	return *fun;
 }
 
-RuntimeValue* RuntimeValue::get_sub(std::string identifier) {
+RuntimeValue* RuntimeValue::get_sub(const std::string& identifier, size_t slot) {
 	if (!str) return nullptr;
-	auto sub_value = (*str)[identifier];
+	size_t index = str->index_of(identifier, slot);
+	if (index == StructShape::npos) return nullptr;
+	auto sub_value = str->slot(index);
 	if (sub_value) {
 		sub_value->value_ref = this;
 		sub_value->access_identifier = identifier;
@@ -741,6 +887,13 @@ RuntimeValue* RuntimeValue::get_sub(std::string identifier) {
 	return sub_value;
 }
 
+RuntimeValue* RuntimeValue::find_sub(const std::string& identifier) const {
+	if (!str) return nullptr;
+	size_t index = str->index_of(identifier);
+	if (index == StructShape::npos) return nullptr;
+	return str->slot(index);
+}
+
 RuntimeValue* RuntimeValue::get_sub(size_t index) {
 	if (!arr) return nullptr;
 	if (index >= (*arr).size()) {
@@ -771,7 +924,10 @@ flx_char* RuntimeValue::get_raw_c() {
 }
 
 flx_string* RuntimeValue::get_raw_s() {
-	return s;
+	if (s && s.use_count() > 1) {
+		s = std::make_shared<flx_string>(*s);
+	}
+	return s.get();
 }
 
 flx_array* RuntimeValue::get_raw_arr() {
@@ -814,10 +970,7 @@ void RuntimeValue::unset() {
 		delete this->c;
 		this->c = nullptr;
 	}
-	if (this->s) {
-		delete this->s;
-		this->s = nullptr;
-	}
+	this->s.reset();
 	if (this->arr) {
 		delete this->arr;
 		this->arr = nullptr;
@@ -864,7 +1017,7 @@ void RuntimeValue::copy_from(RuntimeValue* value) {
 		c = new flx_char(value->get_c());
 		break;
 	case Type::T_STRING:
-		s = new flx_string(value->get_s());
+		s = value->s;
 		break;
 	case Type::T_ARRAY:
 		arr = new flx_array(value->get_arr());
@@ -901,6 +1054,24 @@ std::vector<runtime::GCObject*> RuntimeValue::get_references() {
 	return references;
 }
 
+runtime::GCObject* RuntimeValue::get_native_reference() {
+	if (!TypeUtils::is_struct(type)) {
+		return nullptr;
+	}
+
+	const auto& value = get_str();
+	auto index = value.index_of(modules::Module::NATIVE_OBJECT_NAME);
+	if (index == StructShape::npos) {
+		return nullptr;
+	}
+
+	auto handle = value.slot(index);
+	if (!handle || !TypeUtils::is_int(handle->type) || !handle->i) {
+		return nullptr;
+	}
+	return reinterpret_cast<runtime::GCObject*>(*handle->i);
+}
+
 RuntimeVariable::RuntimeVariable(const std::string& identifier, Type type, Type array_type, std::vector<size_t> dim,
 	const std::string& type_name, const std::string& type_name_space)
 	: Variable(identifier, def_type(type), def_array_type(array_type, dim),
@@ -952,61 +1123,120 @@ std::vector<runtime::GCObject*> RuntimeVariable::get_references() {
 	return references;
 }
 
-flx_bool RuntimeOperations::equals_value(const RuntimeValue* lval, const RuntimeValue* rval, std::vector<uintptr_t> compared) {
-	if (lval->use_ref) {
-		return lval == rval;
-	}
-
-	// to prevent cyclic reference, we add complex structures to compared after the first compare and not compare again
-	switch (lval->type) {
-	case Type::T_ARRAY:
-	case Type::T_STRUCT:
-		if (std::find(compared.begin(), compared.end(), reinterpret_cast<uintptr_t>(lval)) != compared.end()
-			&& std::find(compared.begin(), compared.end(), reinterpret_cast<uintptr_t>(rval)) != compared.end()) {
-			return lval == rval;
-		}
-		else {
-			if (std::find(compared.begin(), compared.end(), reinterpret_cast<uintptr_t>(lval)) == compared.end()) {
-				compared.push_back(reinterpret_cast<uintptr_t>(lval));
-			}
-			if (std::find(compared.begin(), compared.end(), reinterpret_cast<uintptr_t>(rval)) == compared.end()) {
-				compared.push_back(reinterpret_cast<uintptr_t>(rval));
-			}
-		}
+bool RuntimeOperations::shallow_equals(const RuntimeValue* lval, const RuntimeValue* rval, bool& equals) {
+	if (!lval || !rval || lval->use_ref) {
+		equals = lval == rval;
+		return true;
 	}
 
 	switch (lval->type) {
 	case Type::T_VOID:
-		return TypeUtils::is_void(rval->type);
+		equals = TypeUtils::is_void(rval->type);
+		return true;
 	case Type::T_BOOL:
-		return lval->get_b() == rval->get_b();
+		equals = lval->get_b() == rval->get_b();
+		return true;
 	case Type::T_INT:
-		return lval->get_i() == rval->get_i();
+		equals = lval->get_i() == rval->get_i();
+		return true;
 	case Type::T_FLOAT:
-		return lval->get_f() == rval->get_f();
+		equals = lval->get_f() == rval->get_f();
+		return true;
 	case Type::T_CHAR:
-		return lval->get_c() == rval->get_c();
+		equals = lval->get_c() == rval->get_c();
+		return true;
 	case Type::T_STRING:
-		return lval->get_s() == rval->get_s();
+		equals = lval->get_s() == rval->get_s();
+		return true;
 	case Type::T_ARRAY:
-		return RuntimeOperations::equals_array(lval->get_arr(), rval->get_arr(), compared);
+		if (lval->get_arr().size() != rval->get_arr().size()) {
+			equals = false;
+			return true;
+		}
+		return false;
 	case Type::T_STRUCT:
-		return RuntimeOperations::equals_struct(lval->get_str(), rval->get_str(), compared);
+		if (lval->get_str().size() != rval->get_str().size()) {
+			equals = false;
+			return true;
+		}
+		return false;
+	default:
+		equals = false;
+		return true;
 	}
-
-	return false;
 }
 
-flx_bool RuntimeOperations::equals_struct(const flx_struct& lstr, const flx_struct& rstr, std::vector<uintptr_t> compared) {
-	if (lstr.size() != rstr.size()) {
+flx_bool RuntimeOperations::equals_value(const RuntimeValue* lval, const RuntimeValue* rval) {
+	struct Frame {
+		const RuntimeValue* lval;
+		const RuntimeValue* rval;
+		size_t index;
+		size_t size;
+		bool lval_entered;
+		bool rval_entered;
+	};
+
+	// values on the current path, to prevent cyclic references
+	std::unordered_set<const RuntimeValue*> path;
+	std::vector<Frame> stack;
+
+	// returns false if the pair is already known to be different
+	auto enter = [&](const RuntimeValue* l, const RuntimeValue* r) {
+		bool equals = false;
+		if (shallow_equals(l, r, equals)) {
+			return equals;
+		}
+		if (path.contains(l) && path.contains(r)) {
+			return l == r;
+		}
+		bool l_entered = path.insert(l).second;
+		bool r_entered = path.insert(r).second;
+		size_t size = TypeUtils::is_array(l->type) ? l->get_arr().size() : l->get_str().size();
+		stack.push_back(Frame{ l, r, 0, size, l_entered, r_entered });
+		return true;
+	};
+
+	if (!enter(lval, rval)) {
 		return false;
 	}
 
-	for (auto& lval : lstr) {
-		if (rstr.find(lval.first) == rstr.end()) {
-			return false;
+	while (!stack.empty()) {
+		auto& frame = stack.back();
+
+		if (frame.index == frame.size) {
+			if (frame.lval_entered) {
+				path.erase(frame.lval);
+			}
+			if (frame.rval_entered) {
+				path.erase(frame.rval);
+			}
+			stack.pop_back();
+			continue;
 		}
-		if (!equals_value(lval.second, rstr.at(lval.first), compared)) {
+
+		size_t i = frame.index++;
+		const RuntimeValue* l = nullptr;
+		const RuntimeValue* r = nullptr;
+
+		if (TypeUtils::is_array(frame.lval->type)) {
+			const auto& larr = frame.lval->get_arr();
+			const auto& rarr = frame.rval->get_arr();
+			l = larr[i];
+			r = rarr[i];
+		}
+		else {
+			const auto& lstr = frame.lval->get_str();
+			const auto& rstr = frame.rval->get_str();
+			// same shape means same layout, otherwise the member is looked up by name
+			size_t index = lstr.shape() == rstr.shape() ? i : rstr.index_of(lstr.shape()->name_at(i));
+			if (index == StructShape::npos) {
+				return false;
+			}
+			l = lstr.slot(i);
+			r = rstr.slot(index);
+		}
+
+		if (!enter(l, r)) {
 			return false;
 		}
 	}
@@ -1014,25 +1244,175 @@ flx_bool RuntimeOperations::equals_struct(const flx_struct& lstr, const flx_stru
 	return true;
 }
 
-flx_bool RuntimeOperations::equals_array(const flx_array& larr, const flx_array& rarr, std::vector<uintptr_t> compared) {
-	if (larr.size() != rarr.size()) {
+flx_bool RuntimeOperations::contains_value(const flx_array& arr, const RuntimeValue* value) {
+	// same comparisons as shallow_equals, without the per element dispatch
+	auto scan = [&](auto&& equals) {
+		for (size_t i = 0; i < arr.size(); ++i) {
+			if (arr[i] && equals(arr[i])) {
+				return true;
+			}
+		}
+		return false;
+	};
+
+	switch (value->use_ref ? Type::T_UNDEFINED : value->type) {
+	case Type::T_BOOL: {
+		auto b = value->get_b();
+		return scan([b](const RuntimeValue* element) { return element->get_b() == b; });
+	}
+	case Type::T_INT: {
+		auto i = value->get_i();
+		return scan([i](const RuntimeValue* element) { return element->get_i() == i; });
+	}
+	case Type::T_FLOAT: {
+		auto f = value->get_f();
+		return scan([f](const RuntimeValue* element) { return element->get_f() == f; });
+	}
+	case Type::T_CHAR: {
+		auto c = value->get_c();
+		return scan([c](const RuntimeValue* element) { return element->get_c() == c; });
+	}
+	case Type::T_STRING: {
+		auto s = value->get_sv();
+		return scan([s](const RuntimeValue* element) { return element->get_sv() == s; });
+	}
+	default:
+		for (size_t i = 0; i < arr.size(); ++i) {
+			if (equals_value(value, arr[i])) {
+				return true;
+			}
+		}
 		return false;
 	}
+}
 
-	for (size_t i = 0; i < larr.size(); ++i) {
-		if (!equals_value(larr[i], rarr[i], compared)) {
+size_t RuntimeOperations::hash_primitive(const RuntimeValue* value) {
+	switch (value->type) {
+	case Type::T_BOOL:
+		return std::hash<flx_bool>()(value->get_b());
+	case Type::T_INT:
+		return std::hash<flx_int>()(value->get_i());
+	case Type::T_FLOAT: {
+		flx_float f = value->get_f();
+		// 0.0 and -0.0 are equal
+		return std::hash<flx_float>()(f == 0 ? 0 : f);
+	}
+	case Type::T_CHAR:
+		return std::hash<flx_char>()(value->get_c());
+	case Type::T_STRING:
+		return std::hash<std::string_view>()(value->get_sv());
+	default:
+		return static_cast<size_t>(value->type);
+	}
+}
+
+size_t RuntimeOperations::hash_value(const RuntimeValue* value) {
+	struct Frame {
+		const RuntimeValue* value;
+		size_t index;
+		size_t size;
+		size_t hash;
+	};
+
+	auto combine = [](size_t seed, size_t hash) {
+		return seed ^ (hash + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+	};
+
+	std::unordered_set<const RuntimeValue*> path;
+	std::vector<Frame> stack;
+	size_t last = 0;
+
+	// returns true if the value was pushed to be walked, otherwise its hash is at last
+	auto enter = [&](const RuntimeValue* v) {
+		if (!v) {
+			last = 0;
+			return false;
+		}
+		bool is_array = TypeUtils::is_array(v->type);
+		if (!is_array && !TypeUtils::is_struct(v->type)) {
+			last = hash_primitive(v);
+			return false;
+		}
+		if (!path.insert(v).second) {
+			// cyclic reference
+			last = static_cast<size_t>(v->type);
 			return false;
 		}
+		size_t size = is_array ? v->get_arr().size() : v->get_str().size();
+		stack.push_back(Frame{ v, 0, size, combine(static_cast<size_t>(v->type), size) });
+		return true;
+	};
+
+	// adds a member hash to its owner, struct members are added in any order, as equals_value does
+	auto add_member = [&](Frame& frame, size_t index, size_t hash) {
+		if (TypeUtils::is_array(frame.value->type)) {
+			frame.hash = combine(frame.hash, hash);
+		}
+		else {
+			frame.hash += combine(std::hash<std::string>()(frame.value->get_str().shape()->name_at(index)), hash);
+		}
+	};
+
+	if (!enter(value)) {
+		return last;
 	}
 
-	return true;
+	while (!stack.empty()) {
+		auto& frame = stack.back();
+
+		if (frame.index == frame.size) {
+			last = frame.hash;
+			path.erase(frame.value);
+			stack.pop_back();
+			if (!stack.empty()) {
+				add_member(stack.back(), stack.back().index - 1, last);
+			}
+			continue;
+		}
+
+		size_t i = frame.index++;
+		const RuntimeValue* member = TypeUtils::is_array(frame.value->type)
+			? frame.value->get_arr()[i]
+			: frame.value->get_str().slot(i);
+
+		if (!enter(member)) {
+			add_member(stack.back(), i, last);
+		}
+	}
+
+	return last;
 }
 
-std::string RuntimeOperations::parse_value_to_string(const RuntimeValue* value, std::vector<uintptr_t> printed) {
-	if (!value) {
-		return "null";
+int RuntimeOperations::compare_value(RuntimeValue* lval, RuntimeValue* rval) {
+	if (TypeUtils::is_numeric(lval->type) && TypeUtils::is_numeric(rval->type)) {
+		if (TypeUtils::is_int(lval->type) && TypeUtils::is_int(rval->type)) {
+			auto l = *lval->get_raw_i();
+			auto r = *rval->get_raw_i();
+			return (l > r) - (l < r);
+		}
+		auto l = TypeUtils::is_int(lval->type) ? flx_float(*lval->get_raw_i()) : *lval->get_raw_f();
+		auto r = TypeUtils::is_int(rval->type) ? flx_float(*rval->get_raw_i()) : *rval->get_raw_f();
+		return (l > r) - (l < r);
+	}
+
+	if (lval->type == rval->type) {
+		switch (lval->type) {
+		case Type::T_BOOL:
+			return int(*lval->get_raw_b()) - int(*rval->get_raw_b());
+		case Type::T_CHAR:
+			return (*lval->get_raw_c() > *rval->get_raw_c()) - (*lval->get_raw_c() < *rval->get_raw_c());
+		case Type::T_STRING:
+			return lval->get_s().compare(rval->get_s());
+		default:
+			break;
+		}
 	}
 
+	throw std::runtime_error("cannot compare values of type '" + TypeUtils::type_str(lval->type)
+		+ "' and '" + TypeUtils::type_str(rval->type) + "'");
+}
+
+std::string RuntimeOperations::parse_primitive_to_string(const RuntimeValue* value) {
 	std::string str = "";
 	switch (value->type) {
 	case Type::T_VOID:
@@ -1057,31 +1437,6 @@ std::string RuntimeOperations::parse_value_to_string(const RuntimeValue* value,
 	case Type::T_STRING:
 		str = value->get_s();
 		break;
-	case Type::T_STRUCT: {
-		if (std::find(printed.begin(), printed.end(), reinterpret_cast<uintptr_t>(value)) != printed.end()) {
-			std::stringstream s = std::stringstream();
-			if (!value->type_name_space.empty()) {
-				s << value->type_name_space << "::";
-			}
-			s << value->type_name << "@" << reinterpret_cast<uintptr_t>(value) << "{...}";
-			str = s.str();
-		}
-		else {
-			printed.push_back(reinterpret_cast<uintptr_t>(value));
-			str = RuntimeOperations::parse_struct_to_string(value, printed);
-		}
-		break;
-	}
-	case Type::T_ARRAY: {
-		if (std::find(printed.begin(), printed.end(), reinterpret_cast<uintptr_t>(value)) != printed.end()) {
-			str = "array@" + std::to_string(reinterpret_cast<uintptr_t>(value)) + "[...]";
-		}
-		else {
-			printed.push_back(reinterpret_cast<uintptr_t>(value));
-			str = RuntimeOperations::parse_array_to_string(value->get_arr(), printed);
-		}
-		break;
-	}
 	case Type::T_FUNCTION: {
 		str = value->get_fun().first + (value->get_fun().first.empty() ? "" : "::") + value->get_fun().second + "(...)";
 		break;
@@ -1094,47 +1449,92 @@ std::string RuntimeOperations::parse_value_to_string(const RuntimeValue* value,
 	return str;
 }
 
-std::string RuntimeOperations::parse_array_to_string(const flx_array& arr_value, std::vector<uintptr_t> printed) {
-	std::stringstream s = std::stringstream();
-	s << "[";
-	for (auto i = 0; i < arr_value.size(); ++i) {
-		bool isc = arr_value[i] && TypeUtils::is_char(arr_value[i]->type);
-		bool iss = arr_value[i] && TypeUtils::is_string(arr_value[i]->type);
+std::string RuntimeOperations::parse_value_to_string(const RuntimeValue* value) {
+	struct Frame {
+		const RuntimeValue* value;
+		size_t index;
+		size_t size;
+	};
+
+	std::string str;
+	// values on the current path, to prevent cyclic references
+	std::unordered_set<const RuntimeValue*> path;
+	std::vector<Frame> stack;
+
+	// writes the value, arrays and structs are opened and pushed to be walked
+	auto enter = [&](const RuntimeValue* v) {
+		if (!v) {
+			str += "null";
+			return;
+		}
+		if (TypeUtils::is_struct(v->type)) {
+			if (path.contains(v)) {
+				if (!v->type_name_space.empty()) {
+					str += v->type_name_space + "::";
+				}
+				str += v->type_name + "@" + std::to_string(reinterpret_cast<uintptr_t>(v)) + "{...}";
+				return;
+			}
+			path.insert(v);
+			if (!v->type_name_space.empty() && v->type_name_space != Constants::DEFAULT_NAMESPACE) {
+				str += v->type_name_space + "::";
+			}
+			str += v->type_name + "{";
+			stack.push_back(Frame{ v, 0, v->get_str().size() });
+			return;
+		}
+		if (TypeUtils::is_array(v->type)) {
+			if (path.contains(v)) {
+				str += "array@" + std::to_string(reinterpret_cast<uintptr_t>(v)) + "[...]";
+				return;
+			}
+			path.insert(v);
+			str += "[";
+			stack.push_back(Frame{ v, 0, v->get_arr().size() });
+			return;
+		}
+		str += parse_primitive_to_string(v);
+	};
 
-		if (isc) s << "'";
-		else if (iss) s << '"';
+	enter(value);
 
-		s << parse_value_to_string(arr_value[i], printed);
+	while (!stack.empty()) {
+		auto& frame = stack.back();
+		bool is_array = TypeUtils::is_array(frame.value->type);
 
-		if (isc) s << "'";
-		else if (iss) s << '"';
+		if (frame.index == frame.size) {
+			str += is_array ? "]" : "}";
+			path.erase(frame.value);
+			stack.pop_back();
+			continue;
+		}
 
-		if (i < arr_value.size() - 1) {
-			s << ",";
+		size_t i = frame.index++;
+		if (i > 0) {
+			str += ",";
 		}
-	}
-	s << "]";
-	return s.str();
-}
 
-std::string RuntimeOperations::parse_struct_to_string(const RuntimeValue* value, std::vector<uintptr_t> printed) {
-	auto str_value = value->get_str();
-	std::stringstream s = std::stringstream();
-	if (!value->type_name_space.empty() && value->type_name_space != Constants::DEFAULT_NAMESPACE) {
-		s << value->type_name_space << "::";
-	}
-	s << value->type_name << "{";
-	for (auto const& [key, val] : str_value) {
-		s << key << ":";
-		s << parse_value_to_string(val, printed);
-		s << ",";
-	}
-	auto rs = s.str();
-	if (rs[rs.size() - 1] != '{') {
-		s.seekp(-1, std::ios_base::end);
+		if (is_array) {
+			const RuntimeValue* element = frame.value->get_arr()[i];
+			// primitive textual values are quoted inside arrays
+			if (element && TypeUtils::is_char(element->type)) {
+				str += "'" + parse_primitive_to_string(element) + "'";
+			}
+			else if (element && TypeUtils::is_string(element->type)) {
+				str += "\"" + element->get_s() + "\"";
+			}
+			else {
+				enter(element);
+			}
+		}
+		else {
+			const auto& str_value = frame.value->get_str();
+			str += str_value.shape()->name_at(i) + ":";
+			enter(str_value.slot(i));
+		}
 	}
-	s << "}";
-	return s.str();
+
+	return str;
 }
 
 RuntimeValue* RuntimeOperations::do_operation(const std::string& op, RuntimeValue* lval, RuntimeValue* rval, bool is_expr, flx_int str_pos) {
@@ -1319,8 +1719,13 @@ RuntimeValue* RuntimeOperations::do_operation(const std::string& op, RuntimeValu
 					ExceptionHandler::throw_operation_err(op, *lval, *rval);
 				}
 				has_string_access = false;
-				lval->get_s()[str_pos] = rval->get_c();
-				lval->set(lval->get_s());
+				if (static_cast<size_t>(str_pos) >= lval->get_sv().size()) {
+					throw std::runtime_error("invalid string position access");
+				}
+				(*lval->get_raw_s())[str_pos] = rval->get_c();
+			}
+			else if (op == "+=" && lval->get_raw_s()) {
+				lval->get_raw_s()->push_back(rval->get_c());
 			}
 			else {
 				lval->set(do_operation(lval->get_s(), std::string{ rval->get_c() }, op));
@@ -1356,10 +1761,6 @@ RuntimeValue* RuntimeOperations::do_operation(const std::string& op, RuntimeValu
 			&& TypeUtils::is_string(l_type)
 			&& Token::is_equality_op(op)) {
 
-			if (lval->get_s().size() > 30) {
-				int x = 0;
-			}
-
 			res_value = new RuntimeValue((flx_bool)(op == "==" ?
 				lval->get_s() == rval->get_s()
 				: lval->get_s() != rval->get_s()));
@@ -1367,7 +1768,11 @@ RuntimeValue* RuntimeOperations::do_operation(const std::string& op, RuntimeValu
 			break;
 		}
 
-		if (TypeUtils::is_string(l_type)) {
+		if (TypeUtils::is_string(l_type) && op == "+=" && lval->get_raw_s()) {
+			// get_raw_s detaches a shared string, so it can be appended in place
+			lval->get_raw_s()->append(rval->get_s());
+		}
+		else if (TypeUtils::is_string(l_type)) {
 			lval->set(do_operation(lval->get_s(), rval->get_s(), op));
 		}
 		else if (is_expr && TypeUtils::is_char(l_type)) {
@@ -1436,7 +1841,7 @@ RuntimeValue* RuntimeOperations::do_operation(const std::string& op, RuntimeValu
 	}
 	case Type::T_FUNCTION: {
 		if (TypeUtils::is_any(l_var_type) && op == "=") {
-			lval->set(rval->get_str(), rval->type_name, rval->type_name_space);
+			lval->set(rval->get_fun());
 			break;
 		}
 
@@ -1584,6 +1989,114 @@ flx_float RuntimeOperations::do_operation(flx_float lval, flx_float rval, const
 	throw std::runtime_error("invalid '" + op + "' operator");
 }
 
+RuntimeValue* RuntimeOperations::do_typed_operation(const std::string& op, flx_int lval, flx_int rval) {
+	if (op.size() == 1) {
+		switch (op[0]) {
+		case '+':
+			return new RuntimeValue(flx_int(lval + rval));
+		case '-':
+			return new RuntimeValue(flx_int(lval - rval));
+		case '*':
+			return new RuntimeValue(flx_int(lval * rval));
+		case '%':
+			if (rval == 0) {
+				throw std::runtime_error("remainder by zero is undefined");
+			}
+			return new RuntimeValue(flx_int(lval % rval));
+		case '<':
+			return new RuntimeValue(flx_bool(lval < rval));
+		case '>':
+			return new RuntimeValue(flx_bool(lval > rval));
+		case '&':
+			return new RuntimeValue(flx_int(lval & rval));
+		case '|':
+			return new RuntimeValue(flx_int(lval | rval));
+		case '^':
+			return new RuntimeValue(flx_int(lval ^ rval));
+		}
+	}
+	else if (op.size() == 2 && op[1] == '=') {
+		switch (op[0]) {
+		case '=':
+			return new RuntimeValue(flx_bool(lval == rval));
+		case '!':
+			return new RuntimeValue(flx_bool(lval != rval));
+		case '<':
+			return new RuntimeValue(flx_bool(lval <= rval));
+		case '>':
+			return new RuntimeValue(flx_bool(lval >= rval));
+		}
+	}
+	return nullptr;
+}
+
+RuntimeValue* RuntimeOperations::do_typed_operation(const std::string& op, flx_float lval, flx_float rval) {
+	if (op.size() == 1) {
+		switch (op[0]) {
+		case '+':
+			return new RuntimeValue(flx_float(lval + rval));
+		case '-':
+			return new RuntimeValue(flx_float(lval - rval));
+		case '*':
+			return new RuntimeValue(flx_float(lval * rval));
+		case '<':
+			return new RuntimeValue(flx_bool(lval < rval));
+		case '>':
+			return new RuntimeValue(flx_bool(lval > rval));
+		}
+	}
+	else if (op.size() == 2 && op[1] == '=') {
+		switch (op[0]) {
+		case '=':
+			return new RuntimeValue(flx_bool(lval == rval));
+		case '!':
+			return new RuntimeValue(flx_bool(lval != rval));
+		case '<':
+			return new RuntimeValue(flx_bool(lval <= rval));
+		case '>':
+			return new RuntimeValue(flx_bool(lval >= rval));
+		}
+	}
+	return nullptr;
+}
+
+bool RuntimeOperations::do_typed_assignment(const std::string& op, RuntimeValue* lval, RuntimeValue* rval) {
+	if (op.size() != 2 || op[1] != '=') {
+		return false;
+	}
+
+	if (TypeUtils::is_int(lval->type) && TypeUtils::is_int(rval->type)) {
+		flx_int* l = lval->get_raw_i();
+		switch (op[0]) {
+		case '+':
+			*l += rval->get_i();
+			return true;
+		case '-':
+			*l -= rval->get_i();
+			return true;
+		case '*':
+			*l *= rval->get_i();
+			return true;
+		}
+	}
+	else if (TypeUtils::is_float(lval->type) && TypeUtils::is_float(rval->type)) {
+		flx_float* l = lval->get_raw_f();
+		switch (op[0]) {
+		case '+':
+			*l += rval->get_f();
+			return true;
+		case '-':
+			*l -= rval->get_f();
+			return true;
+		case '*':
+			*l *= rval->get_f();
+			return true;
+		}
+	}
+
+	return false;
+}
+
 flx_string RuntimeOperations::do_operation(flx_string lval, flx_string rval, const std::string& op) {
 	if (op == "=") {
 		return rval;
@@ -1607,7 +2120,7 @@ flx_array RuntimeOperations::do_operation(flx_array lval, flx_array rval, const
 	throw std::runtime_error("invalid '" + op + "' operator for types 'array' and 'array'");
 }
 
-void RuntimeOperations::normalize_type(TypeDefinition* owner, RuntimeValue* value) {
+void RuntimeOperations::normalize_type(const TypeDefinition* owner, RuntimeValue* value) {
 	if (TypeUtils::is_string(owner->type) && TypeUtils::is_char(value->type)) {
 		value->type = owner->type;
 		value->set(flx_string{ value->get_c() });
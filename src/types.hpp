@@ -3,8 +3,10 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <stdexcept>
 #include <functional>
 
@@ -15,6 +17,9 @@ namespace core {
 
 	class ASTExprNode;
 	class ASTBlockNode;
+	class ASTProgramNode;
+	class Scope;
+	class FunctionDefinition;
 
 	class SemanticVariable;
 	class RuntimeVariable;
@@ -105,11 +110,88 @@ namespace core {
 	
 	};
 
-	// structure standardized type
-	typedef std::unordered_map<std::string, RuntimeValue*> flx_struct;
+	// hidden class shared by every struct value with the same fields in the same order,
+	// shapes are immutable and adding a field transitions to a child shape
+	class StructShape {
+	private:
+		std::vector<std::string> names;
+		std::unordered_map<std::string, size_t> indexes;
+		mutable std::unordered_map<std::string, std::unique_ptr<StructShape>> transitions;
+
+	public:
+		static const size_t npos = size_t(-1);
+
+		static const StructShape* get_root();
+
+		const StructShape* add(const std::string& name) const;
+		size_t index_of(const std::string& name) const;
+		size_t size() const;
+		const std::string& name_at(size_t index) const;
+	};
+
+	// structure standardized type, field values are stored in slots laid out by its shape
+	class flx_struct {
+	private:
+		const StructShape* _shape;
+		std::vector<RuntimeValue*> _slots;
+
+	public:
+		class const_iterator {
+		private:
+			const flx_struct* owner;
+			size_t index;
+
+		public:
+			const_iterator(const flx_struct* owner, size_t index) : owner(owner), index(index) {}
+
+			std::pair<const std::string&, RuntimeValue*> operator*() const {
+				return { owner->_shape->name_at(index), owner->_slots[index] };
+			}
+			const_iterator& operator++() { ++index; return *this; }
+			bool operator==(const const_iterator& other) const { return index == other.index; }
+			bool operator!=(const const_iterator& other) const { return index != other.index; }
+		};
 
-	// function standardized type
-	typedef std::pair<std::string, std::string> flx_function;
+		flx_struct();
+		flx_struct(const StructShape* shape);
+
+		const StructShape* shape() const;
+		size_t size() const;
+		bool contains(const std::string& identifier) const;
+
+		// returns the slot of the identifier, hint is a slot resolved ahead of time and is checked against the shape
+		size_t index_of(const std::string& identifier, size_t hint = StructShape::npos) const;
+		RuntimeValue*& slot(size_t index);
+		RuntimeValue* slot(size_t index) const;
+
+		RuntimeValue*& operator[](const std::string& identifier);
+		RuntimeValue* at(const std::string& identifier) const;
+
+		const_iterator begin() const;
+		const_iterator end() const;
+	};
+
+	// function standardized type, named functions are resolved by namespace (first) and identifier (second)
+	// when called, closures are called straight through their definition
+	class flx_function {
+	public:
+		std::string first;
+		std::string second;
+		// definition owned by a closure
+		std::shared_ptr<FunctionDefinition> definition;
+		std::shared_ptr<ASTProgramNode> program;
+		// scope that declared a named function when the value was created,
+		// the handle is valid while the scope keeps its generation
+		std::weak_ptr<Scope> scope;
+		size_t generation = 0;
+		// resolved definition, null for overloaded names
+		FunctionDefinition* handle = nullptr;
+
+		flx_function(const std::string& name_space, const std::string& identifier);
+		flx_function(const std::string& name_space, const std::string& identifier, std::shared_ptr<Scope> scope, FunctionDefinition* handle);
+		flx_function(const std::string& name_space, std::shared_ptr<FunctionDefinition> definition, std::shared_ptr<ASTProgramNode> program);
+		flx_function();
+	};
 
 	class CodePosition {
 	public:
@@ -146,17 +228,17 @@ namespace core {
 		static TypeDefinition get_struct(const std::string& type_name,
 			const std::string& type_name_space);
 
-		static bool is_any_or_match_type(TypeDefinition ltype, TypeDefinition rtype, bool strict = false, bool strict_array = false);
-		static bool match_type(TypeDefinition ltype, TypeDefinition rtype, bool strict = false, bool strict_array = false);
-		static bool match_type_bool(TypeDefinition ltype, TypeDefinition rtype);
-		static bool match_type_int(TypeDefinition ltype, TypeDefinition rtype);
-		static bool match_type_float(TypeDefinition ltype, TypeDefinition rtype, bool strict = false);
-		static bool match_type_char(TypeDefinition ltype, TypeDefinition rtype);
-		static bool match_type_string(TypeDefinition ltype, TypeDefinition rtype, bool strict = false);
-		static bool match_type_array(TypeDefinition ltype, TypeDefinition rtype, bool strict = false, bool strict_array = false);
-		static bool match_type_struct(TypeDefinition ltype, TypeDefinition rtype);
-		static bool match_type_function(TypeDefinition ltype, TypeDefinition rtype);
-		static bool match_array_dim(TypeDefinition ltype, TypeDefinition rtype);
+		static bool is_any_or_match_type(const TypeDefinition& ltype, const TypeDefinition& rtype, bool strict = false, bool strict_array = false);
+		static bool match_type(const TypeDefinition& ltype, const TypeDefinition& rtype, bool strict = false, bool strict_array = false);
+		static bool match_type_bool(const TypeDefinition& ltype, const TypeDefinition& rtype);
+		static bool match_type_int(const TypeDefinition& ltype, const TypeDefinition& rtype);
+		static bool match_type_float(const TypeDefinition& ltype, const TypeDefinition& rtype, bool strict = false);
+		static bool match_type_char(const TypeDefinition& ltype, const TypeDefinition& rtype);
+		static bool match_type_string(const TypeDefinition& ltype, const TypeDefinition& rtype, bool strict = false);
+		static bool match_type_array(const TypeDefinition& ltype, const TypeDefinition& rtype, bool strict = false, bool strict_array = false);
+		static bool match_type_struct(const TypeDefinition& ltype, const TypeDefinition& rtype);
+		static bool match_type_function(const TypeDefinition& ltype, const TypeDefinition& rtype);
+		static bool match_array_dim(const TypeDefinition& ltype, const TypeDefinition& rtype);
 
 		static std::string buid_type_str(const TypeDefinition& type);
 		static std::string buid_struct_type_name(const std::string& type_name_space, const std::string& type_name);
@@ -213,6 +295,11 @@ namespace core {
 		size_t pointer = 0;
 		std::shared_ptr<ASTBlockNode> block;
 		bool is_var = false;
+		// variables a closure captured when it was created, visible to its block when called
+		std::shared_ptr<Scope> environment;
+		// builtins have no block, they're called by their native function index
+		bool is_builtin = false;
+		size_t builtin_index = 0;
 
 		FunctionDefinition(const std::string& identifier, Type type, const std::string& type_name,
 			const std::string& type_name_space, Type array_type, const std::vector<size_t>& dim,
@@ -236,6 +323,9 @@ namespace core {
 	public:
 		std::string identifier;
 		std::map<std::string, VariableDefinition> variables;
+		const StructShape* shape;
+		// unique per declaration, copies keep it
+		size_t id;
 
 		StructureDefinition(const std::string& identifier, const std::map<std::string, VariableDefinition>& variables,
 			size_t row, size_t col);
@@ -243,6 +333,9 @@ namespace core {
 		StructureDefinition(const std::string& identifier);
 
 		StructureDefinition();
+
+	private:
+		static size_t next_id();
 	};
 
 	class Variable : public TypeDefinition {
@@ -325,7 +418,8 @@ namespace core {
 		flx_int* i = nullptr;
 		flx_float* f = nullptr;
 		flx_char* c = nullptr;
-		flx_string* s = nullptr;
+		// strings are shared copy-on-write, copies only detach when mutated through get_raw_s
+		std::shared_ptr<flx_string> s;
 		flx_array* arr = nullptr;
 		flx_struct* str = nullptr;
 		flx_function* fun = nullptr;
@@ -364,18 +458,20 @@ namespace core {
 		void set(flx_array, Type array_type, std::vector<size_t> dim, std::string type_name = "", std::string type_name_space = "");
 		void set(flx_struct, std::string type_name, std::string type_name_space);
 		void set(flx_function);
-		void set_sub(std::string identifier, RuntimeValue* sub_value);
+		void set_sub(const std::string& identifier, RuntimeValue* sub_value, size_t slot = StructShape::npos);
 		void set_sub(size_t index, RuntimeValue* sub_value);
 
 		flx_bool get_b() const;
 		flx_int get_i() const;
 		flx_float get_f() const;
 		flx_char get_c() const;
-		flx_string get_s() const;
-		flx_array get_arr() const;
-		flx_struct get_str() const;
-		flx_function get_fun() const;
-		RuntimeValue* get_sub(std::string identifier);
+		const flx_string& get_s() const;
+		std::string_view get_sv() const;
+		const flx_array& get_arr() const;
+		const flx_struct& get_str() const;
+		const flx_function& get_fun() const;
+		RuntimeValue* get_sub(const std::string& identifier, size_t slot = StructShape::npos);
+		RuntimeValue* find_sub(const std::string& identifier) const;
 		RuntimeValue* get_sub(size_t index);
 
 		flx_bool* get_raw_b();
@@ -397,6 +493,7 @@ namespace core {
 		void copy_from(RuntimeValue* value);
 
 		virtual std::vector<GCObject*> get_references() override;
+		virtual GCObject* get_native_reference() override;
 
 	private:
 		void unset();
@@ -425,13 +522,18 @@ namespace core {
 
 	class RuntimeOperations {
 	public:
-		static flx_bool equals_value(const RuntimeValue* lval, const RuntimeValue* rval, std::vector<uintptr_t> compared = std::vector<uintptr_t>());
-		static flx_bool equals_struct(const flx_struct& lstr, const flx_struct& rstr, std::vector<uintptr_t> compared);
-		static flx_bool equals_array(const flx_array& larr, const flx_array& rarr, std::vector<uintptr_t> compared);
+		// deep equality, arrays and structs are walked iteratively and a value already on the
+		// current path is only equal to itself, so cyclic values terminate
+		static flx_bool equals_value(const RuntimeValue* lval, const RuntimeValue* rval);
+		// deep hash, equal values by equals_value have the same hash
+		static size_t hash_value(const RuntimeValue* value);
+		// linear search by equals_value, primitive values are compared inline
+		static flx_bool contains_value(const flx_array& arr, const RuntimeValue* value);
 
-		static std::string parse_value_to_string(const RuntimeValue* value, std::vector<uintptr_t> printed = std::vector<uintptr_t>());
-		static std::string parse_array_to_string(const flx_array& arr_value, std::vector<uintptr_t> printed);
-		static std::string parse_struct_to_string(const RuntimeValue* value, std::vector<uintptr_t> printed);
+		// total order for primitive values, used by native ordered containers
+		static int compare_value(RuntimeValue* lval, RuntimeValue* rval);
+
+		static std::string parse_value_to_string(const RuntimeValue* value);
 
 		static RuntimeValue* do_operation(const std::string& op, RuntimeValue* lval, RuntimeValue* rval, bool is_expr = false, flx_int str_pos = -1);
 		static flx_bool do_relational_operation(const std::string& op, RuntimeValue* lval, RuntimeValue* rval);
@@ -440,8 +542,20 @@ namespace core {
 		static flx_float do_operation(flx_float lval, flx_float rval, const std::string& op);
 		static flx_string do_operation(flx_string lval, flx_string rval, const std::string& op);
 		static flx_array do_operation(flx_array lval, flx_array rval, const std::string& op);
+		// operations between two primitives of the same type, used by nodes typed by the semantic analysis,
+		// returns nullptr when the operator has no specialized path and the generic operation must be used
+		static RuntimeValue* do_typed_operation(const std::string& op, flx_int lval, flx_int rval);
+		static RuntimeValue* do_typed_operation(const std::string& op, flx_float lval, flx_float rval);
+		// in place compound assignment between two primitives of the same type, returns false when not specialized
+		static bool do_typed_assignment(const std::string& op, RuntimeValue* lval, RuntimeValue* rval);
+
+		static void normalize_type(const TypeDefinition* owner, RuntimeValue* value);
 
-		static void normalize_type(TypeDefinition* owner, RuntimeValue* value);
+	private:
+		// compares values that are not walked, returns false when both must be walked member by member
+		static bool shallow_equals(const RuntimeValue* lval, const RuntimeValue* rval, bool& equals);
+		static size_t hash_primitive(const RuntimeValue* value);
+		static std::string parse_primitive_to_string(const RuntimeValue* value);
 
 	};
 
@@ -3,6 +3,10 @@
 #include <filesystem>
 #include <random>
 #include <iterator>
+#include <functional>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
 
 using namespace utils;
 
@@ -13,6 +17,7 @@ using namespace utils;
 #include <fcntl.h>
 #include <sys/select.h>
 #include <limits.h>
+#include <pthread.h>
 
 bool utils::_kbhit() {
     termios oldt, newt;
@@ -142,6 +147,21 @@ intmax_t StringUtils::hashcode(const std::string& str) {
 	return h;
 }
 
+size_t StringUtils::find(std::string_view text, std::string_view pattern) {
+	// the skip table only pays off when there is enough text to skip over
+	if (pattern.size() < 8 || text.size() < 256) {
+		return text.find(pattern);
+	}
+
+	auto it = std::search(text.begin(), text.end(), std::boyer_moore_horspool_searcher(pattern.begin(), pattern.end()));
+	return it == text.end() ? std::string_view::npos : static_cast<size_t>(it - text.begin());
+}
+
+size_t StringUtils::find(std::string_view text, char c) {
+	auto pos = static_cast<const char*>(std::memchr(text.data(), c, text.size()));
+	return pos ? static_cast<size_t>(pos - text.data()) : std::string_view::npos;
+}
+
 // CollectionUtils
 
 // PathUtils
@@ -202,3 +222,70 @@ std::string utils::FlexaUUID::generate() {
 
 	return res;
 }
+
+// ThreadUtils
+
+struct StackThreadTask {
+	const std::function<void()>& function;
+	std::exception_ptr exception;
+};
+
+#ifdef linux
+
+static void* run_stack_thread(void* arg) {
+	auto task = static_cast<StackThreadTask*>(arg);
+	try {
+		task->function();
+	}
+	catch (...) {
+		task->exception = std::current_exception();
+	}
+	return nullptr;
+}
+
+#elif defined(_WIN32) || defined(WIN32)
+
+static DWORD WINAPI run_stack_thread(LPVOID arg) {
+	auto task = static_cast<StackThreadTask*>(arg);
+	try {
+		task->function();
+	}
+	catch (...) {
+		task->exception = std::current_exception();
+	}
+	return 0;
+}
+
+#endif // linux
+
+void ThreadUtils::run_with_stack_size(size_t stack_size, const std::function<void()>& function) {
+	StackThreadTask task{ function, nullptr };
+
+#ifdef linux
+
+	pthread_attr_t attr;
+	pthread_attr_init(&attr);
+	pthread_attr_setstacksize(&attr, stack_size);
+	pthread_t thread;
+	int res = pthread_create(&thread, &attr, run_stack_thread, &task);
+	pthread_attr_destroy(&attr);
+	if (res != 0) {
+		throw std::runtime_error("failed to create the execution thread");
+	}
+	pthread_join(thread, nullptr);
+
+#elif defined(_WIN32) || defined(WIN32)
+
+	HANDLE thread = CreateThread(nullptr, stack_size, run_stack_thread, &task, STACK_SIZE_PARAM_IS_A_RESERVATION, nullptr);
+	if (!thread) {
+		throw std::runtime_error("failed to create the execution thread");
+	}
+	WaitForSingleObject(thread, INFINITE);
+	CloseHandle(thread);
+
+#endif // linux
+
+	if (task.exception) {
+		std::rethrow_exception(task.exception);
+	}
+}
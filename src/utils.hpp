@@ -2,10 +2,12 @@
 #define UTILS_HPP
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <algorithm>
 #include <iostream>
 #include <cstdint>
+#include <functional>
 
 namespace utils {
 
@@ -49,6 +51,10 @@ char _getch();
 
 		static intmax_t hashcode(const std::string& str);
 
+		// substring search, long patterns over long texts use boyer-moore-horspool
+		static size_t find(std::string_view text, std::string_view pattern);
+		static size_t find(std::string_view text, char c);
+
 	};
 
 	class CollectionUtils {
@@ -70,6 +76,13 @@ char _getch();
 		static std::string generate();
 	};
 
+	class ThreadUtils {
+	public:
+		// runs the function in a new thread with the given stack size and waits for it,
+		// exceptions are rethrown in the calling thread
+		static void run_with_stack_size(size_t stack_size, const std::function<void()>& function);
+	};
+
 }
 
 #endif // !UTILS_HPP
@@ -1,8 +1,24 @@
 #include "visitor.hpp"
 
+#include <cmath>
+#include <cstdint>
+#include <functional>
+
 using namespace core;
 
 Visitor::Visitor(const std::map<std::string, std::shared_ptr<ASTProgramNode>>& programs, std::shared_ptr<ASTProgramNode> main_program, const std::string& current_this_name)
 	: programs(programs), main_program(main_program), curr_row(0), curr_col(0) {
 	current_program_stack.push(main_program);
 };
+
+intmax_t Visitor::hash_float(flx_float value) {
+	if (std::trunc(value) == value
+		&& value >= static_cast<flx_float>(INTMAX_MIN) && value < static_cast<flx_float>(INTMAX_MAX)) {
+		return static_cast<intmax_t>(value);
+	}
+	return static_cast<intmax_t>(std::hash<flx_float>{}(value));
+}
+
+intmax_t Visitor::hash_string(std::string_view value) {
+	return static_cast<intmax_t>(std::hash<std::string_view>{}(value));
+}
@@ -2,6 +2,7 @@
 #define VISITOR_HPP
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <stack>
 #include <map>
@@ -61,7 +62,6 @@ namespace core {
 	class ASTIsArrayNode;
 	class ASTIsAnyNode;
 	class ASTValueNode;
-	class ASTBuiltinCallNode;
 
 	class Visitor {
 	public:
@@ -128,7 +128,6 @@ namespace core {
 		virtual void visit(std::shared_ptr<ASTIsArrayNode>) = 0;
 		virtual void visit(std::shared_ptr<ASTIsAnyNode>) = 0;
 		virtual void visit(std::shared_ptr<ASTValueNode>) = 0;
-		virtual void visit(std::shared_ptr<ASTBuiltinCallNode>) = 0;
 
 		virtual intmax_t hash(std::shared_ptr<ASTExprNode>) = 0;
 		virtual intmax_t hash(std::shared_ptr<ASTValueNode>) = 0;
@@ -139,6 +138,10 @@ namespace core {
 		virtual intmax_t hash(std::shared_ptr<ASTLiteralNode<flx_char>>) = 0;
 		virtual intmax_t hash(std::shared_ptr<ASTLiteralNode<flx_string>>) = 0;
 
+		// switch case hashes, integral floats hash as their integer value so they match int cases
+		static intmax_t hash_float(flx_float value);
+		static intmax_t hash_string(std::string_view value);
+
 	};
 
 }